@@ -0,0 +1,65 @@
+#ifndef NCCAPI_CANDLE_CACHE_HPP
+#define NCCAPI_CANDLE_CACHE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "nccapi/candle.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief Persistent candle store, one file per (exchange, instrument, timeframe).
+ * Besides the candles, every file records the time ranges it fully covers, so a
+ * request only has to download the gaps. Files live under
+ * `<directory>/<exchange>/<instrument>/<timeframe>.bin`.
+ *
+ * File layout (native endianness):
+ *   char[4]  magic "NCC1"
+ *   uint32   range count, then that many [from, to] int64 pairs (ms, inclusive)
+ *   uint64   candle count, then that many rows of uint64 timestamp + 5 doubles (OHLCV)
+ */
+class CandleCache {
+public:
+    using Range = std::pair<int64_t, int64_t>; // [from, to] in ms, inclusive
+
+    explicit CandleCache(std::string directory);
+
+    /**
+     * @brief Sub-ranges of [from_date, to_date] not covered yet, in ascending order.
+     */
+    std::vector<Range> missing(const std::string& exchange, const std::string& instrument,
+                               const std::string& timeframe, int64_t from_date, int64_t to_date);
+
+    /**
+     * @brief Merge `candles` into the store (newer rows replace rows with the same timestamp)
+     * and mark the `covered` ranges as complete. With no ranges, only the rows are stored.
+     */
+    void store(const std::string& exchange, const std::string& instrument, const std::string& timeframe,
+               const std::vector<Range>& covered, const std::vector<Candle>& candles);
+
+    /**
+     * @brief Cached candles with from_date <= timestamp <= to_date, ascending.
+     */
+    std::vector<Candle> load(const std::string& exchange, const std::string& instrument,
+                             const std::string& timeframe, int64_t from_date, int64_t to_date);
+
+private:
+    struct Entry {
+        std::vector<Range> ranges;
+        std::vector<Candle> candles;
+    };
+
+    std::string path_for(const std::string& exchange, const std::string& instrument, const std::string& timeframe) const;
+    Entry read(const std::string& path) const;
+    void write(const std::string& path, const Entry& entry) const;
+
+    std::string directory_;
+    std::mutex mutex_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_CANDLE_CACHE_HPP
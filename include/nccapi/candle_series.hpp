@@ -0,0 +1,130 @@
+#ifndef NCCAPI_CANDLE_SERIES_HPP
+#define NCCAPI_CANDLE_SERIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include "nccapi/candle.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief std::allocator replacement returning `Alignment`-byte aligned storage.
+ */
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Column-oriented (structure-of-arrays) OHLCV series.
+ * Each field lives in its own contiguous, 64-byte aligned array, so a column
+ * can be handed directly to vectorised analytics without a copy.
+ * Rows are kept in the order they are appended (ascending timestamp when
+ * filled by Client::get_historical_candle_series).
+ */
+class CandleSeries {
+public:
+    template <typename T>
+    using Column = std::vector<T, AlignedAllocator<T>>;
+
+    CandleSeries() = default;
+
+    size_t size() const { return timestamp_.size(); }
+    bool empty() const { return timestamp_.empty(); }
+
+    void reserve(size_t n) {
+        timestamp_.reserve(n);
+        open_.reserve(n);
+        high_.reserve(n);
+        low_.reserve(n);
+        close_.reserve(n);
+        volume_.reserve(n);
+    }
+
+    void clear() {
+        timestamp_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+    }
+
+    void push_back(const Candle& candle) {
+        timestamp_.push_back(candle.timestamp);
+        open_.push_back(candle.open);
+        high_.push_back(candle.high);
+        low_.push_back(candle.low);
+        close_.push_back(candle.close);
+        volume_.push_back(candle.volume);
+    }
+
+    /**
+     * @brief Materialise row `i` as a Candle.
+     */
+    Candle operator[](size_t i) const {
+        Candle candle;
+        candle.timestamp = timestamp_[i];
+        candle.open = open_[i];
+        candle.high = high_[i];
+        candle.low = low_[i];
+        candle.close = close_[i];
+        candle.volume = volume_[i];
+        return candle;
+    }
+
+    const uint64_t* timestamps() const { return timestamp_.data(); }
+    const double* opens() const { return open_.data(); }
+    const double* highs() const { return high_.data(); }
+    const double* lows() const { return low_.data(); }
+    const double* closes() const { return close_.data(); }
+    const double* volumes() const { return volume_.data(); }
+
+    static CandleSeries from_candles(const std::vector<Candle>& candles) {
+        CandleSeries series;
+        series.reserve(candles.size());
+        for (const auto& candle : candles) series.push_back(candle);
+        return series;
+    }
+
+    std::vector<Candle> to_candles() const {
+        std::vector<Candle> candles;
+        candles.reserve(size());
+        for (size_t i = 0; i < size(); ++i) candles.push_back((*this)[i]);
+        return candles;
+    }
+
+private:
+    Column<uint64_t> timestamp_;
+    Column<double> open_;
+    Column<double> high_;
+    Column<double> low_;
+    Column<double> close_;
+    Column<double> volume_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_CANDLE_SERIES_HPP
@@ -0,0 +1,97 @@
+#ifndef NCCAPI_CANDLE_STREAM_HPP
+#define NCCAPI_CANDLE_STREAM_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "nccapi/candle.hpp"
+#include "nccapi/timeframe.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief One live candle update. `candle.timestamp` is the bar's open time (ms, aligned
+ * to `timeframe`). While `closed` is false the bar is still forming and later updates
+ * replace it; the final values of a bar are delivered once with `closed` set.
+ * The string views stay valid until the subscription is cancelled or destroyed.
+ */
+struct CandleUpdate {
+    std::string_view exchange;
+    std::string_view instrument;
+    Timeframe timeframe;
+    Candle candle;
+    bool closed = false;
+};
+
+/**
+ * @brief Receives CandleUpdates on the session's event thread: keep it short, or hand
+ * the update over to another thread.
+ */
+using CandleHandler = std::function<void(const CandleUpdate&)>;
+
+/**
+ * @brief Turns the successive snapshots of forming bars that a candle stream pushes
+ * into CandleUpdates: every snapshot is forwarded as in progress. The bar is closed by
+ * advance() once the clock passes its end plus `close_delay`, or earlier by the first
+ * snapshot of a newer bar. Snapshots of an older or already closed bar are dropped.
+ * update() and advance() may be called from different threads; the handler runs under
+ * the assembler's lock, so updates never overlap (it must not call back into it).
+ */
+class CandleAssembler {
+public:
+    /**
+     * @brief Called with the time (ms) at which advance() has to run next.
+     */
+    using Scheduler = std::function<void(int64_t deadline_ms)>;
+
+    CandleAssembler(std::string exchange,
+                    std::string instrument,
+                    Timeframe timeframe,
+                    CandleHandler handler,
+                    std::chrono::milliseconds close_delay = std::chrono::milliseconds(250));
+
+    /**
+     * @brief Install the callback asking for advance() to be called at a deadline.
+     * Without one, bars are only closed by later snapshots or explicit advance() calls.
+     */
+    void set_scheduler(Scheduler scheduler);
+
+    /**
+     * @brief One snapshot of the bar containing `candle.timestamp` (ms).
+     */
+    void update(const Candle& candle);
+
+    /**
+     * @brief Close the forming bar if `now_ms` is past its end plus the close delay.
+     */
+    void advance(int64_t now_ms);
+
+    /**
+     * @brief Deliver the forming bar as closed now, whatever the clock.
+     * Does nothing if no bar is open; later snapshots of that bar are ignored.
+     */
+    void close();
+
+private:
+    void emit(bool closed);
+
+    std::string exchange_;
+    std::string instrument_;
+    Timeframe timeframe_;
+    CandleHandler handler_;
+    std::chrono::milliseconds close_delay_;
+    Scheduler scheduler_;
+
+    std::mutex mutex_;
+    Candle current_;
+    int64_t end_ = 0;      // Exclusive end of current_ (ms)
+    bool started_ = false; // current_ holds a bar (open or closed)
+    bool open_ = false;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_CANDLE_STREAM_HPP
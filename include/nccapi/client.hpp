@@ -5,18 +5,83 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <optional>
 #include "nccapi/instrument.hpp"
 #include "nccapi/exchange.hpp"
 #include "nccapi/candle.hpp"
+#include "nccapi/candle_series.hpp"
+#include "nccapi/fixed_candle.hpp"
+#include "nccapi/rate_limit.hpp"
+#include "nccapi/instrument_snapshot.hpp"
+#include "nccapi/compact_instrument.hpp"
+#include "nccapi/instrument_catalog.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/candle_stream.hpp"
+#include "nccapi/trade_stream.hpp"
+#include "nccapi/order_book.hpp"
+#include "nccapi/subscription.hpp"
 
 namespace nccapi {
 
+class Executor;
+class CandleCache;
+class UnifiedSession;
+class DeadlineTimer;
+
+/**
+ * @brief Construction options for nccapi::Client.
+ */
+struct ClientOptions {
+    size_t async_workers = 32; // Maximum number of async calls executing at once (>= exchange count for a full get_all_pairs fan-out)
+    size_t pages_in_flight = 4; // Concurrent page requests per paginated get_historical_candles call
+    std::map<std::string, RateLimit> rate_limits; // Per-exchange overrides of default_rate_limits()
+    std::string cache_dir; // On-disk candle cache directory; empty disables the cache
+    std::string snapshot_dir; // Instrument catalog snapshots (<snapshot_dir>/<exchange>.bin); empty disables them
+    std::chrono::seconds catalog_ttl = std::chrono::hours(1); // Age after which a snapshot is refreshed in the background
+    InfoMode info_mode = InfoMode::Eager; // How Instrument::info is kept: Eager copies, Lazy decodes on access, Skip drops it
+};
+
+/**
+ * @brief Outcome of a per-exchange call in a bulk request.
+ */
+enum class FetchStatus {
+    Ok,      // Completed (the result may legitimately be empty)
+    Error,   // The exchange call threw; see `error`
+    Timeout  // Not finished before the overall deadline
+};
+
+/**
+ * @brief Per-exchange result of Client::get_all_pairs.
+ */
+struct PairsResult {
+    FetchStatus status = FetchStatus::Timeout;
+    std::vector<Instrument> instruments;
+    std::string error;
+    std::vector<PartialFailure> partial_failures; // Failed sub-requests of an Ok result: `instruments` is incomplete
+};
+
+/**
+ * @brief Completion callbacks for the async API.
+ * On failure the result is empty and `error` holds the exception. A call still queued
+ * when the Client is destroyed is not started: its callback receives a
+ * std::runtime_error (and its future a std::future_error, broken_promise) instead.
+ */
+using PairsCallback = std::function<void(std::vector<Instrument> pairs, std::exception_ptr error)>;
+using CandlesCallback = std::function<void(std::vector<Candle> candles, std::exception_ptr error)>;
+
 /**
  * @brief Main entry point (Facade) for the nCCAPI library.
  */
 class Client {
 public:
     Client();
+    explicit Client(const ClientOptions& options);
     ~Client();
 
     /**
@@ -28,11 +93,74 @@ public:
      * @brief Generic function to get pairs (instruments) from any exchange.
      * @param exchange_name The name of the exchange (e.g., "coinbase", "binance").
      * @return List of instruments. Throws if exchange is not supported or on error.
+     * With ClientOptions::snapshot_dir set, the catalog is answered from the snapshot
+     * loaded at startup; once older than ClientOptions::catalog_ttl it is still returned
+     * while a refresh runs in the background. Only a missing snapshot is downloaded
+     * synchronously.
      */
     std::vector<Instrument> get_pairs(const std::string& exchange_name);
 
+    /**
+     * @brief get_pairs reporting failed sub-requests of exchanges that load their catalog
+     * with several concurrent requests (OKX, Bybit, Deribit, Bitget Futures, Gate.io
+     * Perpetual): the instruments of the other sub-requests are returned and each failed
+     * one is appended to `failures` (the plain overload prints them as [WARN] lines).
+     * An incomplete catalog is never written to the snapshot, so the next call retries.
+     */
+    std::vector<Instrument> get_pairs(const std::string& exchange_name, std::vector<PartialFailure>& failures);
+
+    /**
+     * @brief get_pairs as an indexed InstrumentCatalog (O(1) lookup by id and symbol).
+     * The catalog is built once and shared: it is rebuilt only when the underlying
+     * snapshot changes or, without ClientOptions::snapshot_dir, after catalog_ttl.
+     */
+    std::shared_ptr<const InstrumentCatalog> get_catalog(const std::string& exchange_name);
+
+    /**
+     * @brief get_pairs as a CompactCatalog: string fields interned, `info` dropped.
+     * Meant for large catalogs (options) that are kept in memory and filtered often.
+     */
+    CompactCatalog get_compact_pairs(const std::string& exchange_name);
+
+    /**
+     * @brief Fetch the instruments of every supported exchange concurrently.
+     * All catalog requests are issued at once; exchanges that have not answered
+     * when `timeout` expires are reported as FetchStatus::Timeout (their late
+     * results are discarded). Cold start therefore costs one slow round trip
+     * instead of the sum of all of them, provided ClientOptions::async_workers
+     * is at least the number of exchanges.
+     * @param timeout Overall deadline for the whole fan-out.
+     * @return Map of exchange name to result and status.
+     */
+    std::map<std::string, PairsResult> get_all_pairs(std::chrono::milliseconds timeout = std::chrono::seconds(20));
+
+    /**
+     * @brief Last price, best bid/ask and 24h volume of every instrument of an exchange,
+     * as a columnar TickerTable, from its all-symbols ticker endpoint: a full-universe
+     * snapshot costs one request instead of one per symbol. Implemented for Binance,
+     * OKX and Bybit (spot and futures/swaps, one concurrent request per type), Gate.io
+     * and KuCoin (spot); other exchanges throw std::runtime_error.
+     * TickerTable::timestamp is the local time the snapshot was received.
+     */
+    TickerTable get_tickers(const std::string& exchange_name);
+
+    /**
+     * @brief get_tickers appending the instrument types whose request failed (OKX, Bybit)
+     * to `failures` instead of printing them; the other types are still returned.
+     */
+    TickerTable get_tickers(const std::string& exchange_name, std::vector<PartialFailure>& failures);
+
     /**
      * @brief Generic function to get historical candles from any exchange.
+     * Ranges longer than the exchange's per-request maximum are fetched page by page
+     * (ClientOptions::pages_in_flight at a time) and returned stitched, sorted and
+     * deduplicated, so a multi-month range is not silently truncated to one page.
+     * With ClientOptions::cache_dir set, ranges (from_date > 0) are served from the
+     * on-disk cache and only the gaps it does not cover yet are downloaded.
+     * A timeframe the exchange does not serve natively (Exchange::timeframes) is built
+     * by resampling the longest native interval that divides it ("4h" from "1h" on
+     * Coinbase); a malformed or unreachable timeframe throws std::invalid_argument
+     * before any request is sent.
      * @param exchange_name The name of the exchange.
      * @param instrument_name The instrument identifier.
      * @param timeframe The time interval (default "1m").
@@ -46,6 +174,125 @@ public:
                                                int64_t from_date = 0,
                                                int64_t to_date = 0);
 
+    /**
+     * @brief Columnar variant of get_historical_candles.
+     * Returns the same rows as get_historical_candles. Pages are appended to the series
+     * in order as soon as every earlier page has arrived, then freed: the peak is the
+     * series (reserved once for every candle open time in the range) plus at most
+     * ClientOptions::pages_in_flight decoded pages. Resampled timeframes and calls served
+     * by the candle cache still build a full std::vector<Candle> first.
+     */
+    CandleSeries get_historical_candle_series(const std::string& exchange_name,
+                                              const std::string& instrument_name,
+                                              const std::string& timeframe = "1m",
+                                              int64_t from_date = 0,
+                                              int64_t to_date = 0);
+
+    /**
+     * @brief Fixed-point variant of get_historical_candle_series.
+     * Prices and volumes are int64 mantissas at the instrument's FixedScale, derived from
+     * its tick_size and step_size in the exchange catalog (get_pairs: set
+     * ClientOptions::snapshot_dir to avoid a catalog download per call). An instrument
+     * missing from the catalog gets the default scale of 8 digits.
+     */
+    FixedCandleSeries get_historical_fixed_series(const std::string& exchange_name,
+                                                  const std::string& instrument_name,
+                                                  const std::string& timeframe = "1m",
+                                                  int64_t from_date = 0,
+                                                  int64_t to_date = 0);
+
+    /**
+     * @brief Asynchronous variant of get_pairs.
+     * Throws immediately if the exchange is not supported; any other error is reported through the future.
+     */
+    std::future<std::vector<Instrument>> get_pairs_async(const std::string& exchange_name);
+
+    /**
+     * @brief Asynchronous variant of get_pairs invoking `callback` on a worker thread.
+     */
+    void get_pairs_async(const std::string& exchange_name, PairsCallback callback);
+
+    /**
+     * @brief Asynchronous variant of get_historical_candles.
+     * Throws immediately if the exchange is not supported; any other error is reported through the future.
+     */
+    std::future<std::vector<Candle>> get_historical_candles_async(const std::string& exchange_name,
+                                                                  const std::string& instrument_name,
+                                                                  const std::string& timeframe = "1m",
+                                                                  int64_t from_date = 0,
+                                                                  int64_t to_date = 0);
+
+    /**
+     * @brief Asynchronous variant of get_historical_candles invoking `callback` on a worker thread.
+     */
+    void get_historical_candles_async(const std::string& exchange_name,
+                                      const std::string& instrument_name,
+                                      const std::string& timeframe,
+                                      int64_t from_date,
+                                      int64_t to_date,
+                                      CandlesCallback callback);
+
+    /**
+     * @brief Stream live candles of one instrument over the exchange's websocket
+     * (a ccapi CANDLESTICK subscription) instead of polling get_historical_candles.
+     * `handler` receives every update of the forming bar (CandleUpdate::closed false)
+     * and then the final bar (closed true): a background timer closes each bar 250 ms
+     * after its end, or the exchange's first update of the next bar closes it earlier.
+     * Updates of one subscription arrive in order, on the session's event thread or on
+     * the timer thread, never concurrently.
+     * A timeframe the exchange does not stream natively (Exchange::timeframes, e.g. "10s"
+     * on Kraken), and every timeframe on exchanges without a candle stream
+     * (Exchange::streams_candles: Bitstamp, Gemini), is built locally from the trade
+     * stream as by subscribe_trade_candles. A malformed timeframe throws
+     * std::invalid_argument. A stream the exchange or ccapi rejects is reported on the
+     * handle (Subscription::failed, error, on_error).
+     * @return Handle that stops delivery when cancelled or destroyed.
+     */
+    Subscription subscribe_candles(const std::string& exchange_name,
+                                   const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   CandleHandler handler);
+
+    /**
+     * @brief Stream the public trades of one instrument (a ccapi TRADE subscription).
+     * Trades of one subscription arrive in order, on the session's event thread.
+     * @return Handle that stops delivery when cancelled or destroyed.
+     */
+    Subscription subscribe_trades(const std::string& exchange_name,
+                                  const std::string& instrument_name,
+                                  TradeHandler handler);
+
+    /**
+     * @brief Live candles of any timeframe built locally from the trade stream by a
+     * TradeAggregator. Bars are aligned like Timeframe::bucket_start and closed on time:
+     * a background timer closes each bar `options.close_delay` after its end, even when
+     * no further trade arrives, so no REST polling is involved. Closed bars are
+     * delivered on the session's event thread or on the timer thread, never concurrently.
+     * Throws std::invalid_argument if the timeframe is malformed.
+     */
+    Subscription subscribe_trade_candles(const std::string& exchange_name,
+                                         const std::string& instrument_name,
+                                         const std::string& timeframe,
+                                         CandleHandler handler,
+                                         TradeAggregatorOptions options = {});
+
+    /**
+     * @brief Stream the L2 order book of one instrument (a ccapi MARKET_DEPTH subscription
+     * returning a snapshot, then only the changed levels). The book is kept in an
+     * OrderBook on the instrument's tick grid (Instrument::tick_size from get_catalog;
+     * a [WARN] is printed and a 1e-8 grid used if the instrument is not in the catalog).
+     * `handler` is called after every message with the updated book, on the session's
+     * event thread. Subscriptions to the same book (exchange, instrument and depth) share
+     * one stream and one OrderBook; each handler's first update is the whole book with
+     * OrderBookUpdate::snapshot set.
+     * @param depth Levels per side requested from the exchange (MARKET_DEPTH_MAX).
+     * @return Handle that stops delivery when cancelled or destroyed.
+     */
+    Subscription subscribe_order_book(const std::string& exchange_name,
+                                      const std::string& instrument_name,
+                                      OrderBookHandler handler,
+                                      size_t depth = 20);
+
     /**
      * @brief Access the specific exchange instance directly if needed.
      */
@@ -54,8 +301,55 @@ public:
 private:
     // Map of exchange name to Exchange instance
     std::map<std::string, std::shared_ptr<Exchange>> exchanges_;
+    std::shared_ptr<UnifiedSession> session_; // Shared with the exchanges; carries the market data subscriptions
+    std::shared_ptr<DeadlineTimer> timer_; // Closes trade-built bars on time; shared with their aggregators
+
+    size_t pages_in_flight_;
+    std::unique_ptr<CandleCache> cache_;
+
+    std::string snapshot_dir_;
+    std::chrono::seconds catalog_ttl_;
+    std::mutex catalog_mutex_;
+    std::map<std::string, InstrumentSnapshot> catalogs_;
+    std::set<std::string> refreshing_;
+
+    struct IndexedCatalog {
+        int64_t fetched_at = 0; // Snapshot the catalog was built from (or build time without snapshots)
+        std::shared_ptr<const InstrumentCatalog> catalog;
+    };
+    std::map<std::string, IndexedCatalog> indexed_catalogs_;
+
+    // One OrderBook per shared order book stream (exchange, instrument, depth), kept for the
+    // client's lifetime: ccapi cannot unsubscribe, so the book follows the stream even
+    // while nobody watches it, and a later subscriber starts from an up-to-date book.
+    struct OrderBookFeed;
+    std::mutex order_books_mutex_;
+    std::map<std::string, std::shared_ptr<OrderBookFeed>> order_books_;
+
+    // Declared last so that it is destroyed (and its workers joined) first
+    std::unique_ptr<Executor> executor_;
 
     void load_exchange(const std::string& exchange_name);
+
+    std::string snapshot_path(const std::string& exchange_name) const;
+    std::vector<Instrument> refresh_catalog(const std::string& exchange_name, std::vector<PartialFailure>& failures);
+
+    FixedScale fixed_scale(const std::string& exchange_name, const std::string& instrument_name);
+    double tick_size(const std::string& exchange_name, const std::string& instrument_name);
+
+    // Which native timeframe to request for `timeframe`, and the target to resample to
+    // when the exchange does not serve it. Throws std::invalid_argument if it cannot.
+    struct TimeframePlan {
+        std::string fetch;
+        std::optional<Timeframe> resample_to;
+    };
+    static TimeframePlan plan_timeframe(const Exchange& exchange, const std::string& timeframe);
+
+    std::vector<Candle> fetch_cached_candles(Exchange& exchange,
+                                             const std::string& instrument_name,
+                                             const std::string& timeframe,
+                                             int64_t from_date,
+                                             int64_t to_date);
 };
 
 } // namespace nccapi
@@ -0,0 +1,86 @@
+#ifndef NCCAPI_COMPACT_INSTRUMENT_HPP
+#define NCCAPI_COMPACT_INSTRUMENT_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "nccapi/instrument.hpp"
+#include "nccapi/symbol_table.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief Instrument whose string fields are SymbolIds into the owning CompactCatalog's table.
+ * Assets, type, settle and option fields repeat across thousands of rows and are
+ * stored once; `info` is not kept (use Instrument for the raw exchange data).
+ */
+struct CompactInstrument {
+    SymbolId id = SymbolTable::kEmpty;
+    SymbolId symbol = SymbolTable::kEmpty;
+    SymbolId base = SymbolTable::kEmpty;
+    SymbolId quote = SymbolTable::kEmpty;
+    SymbolId settle = SymbolTable::kEmpty;
+    SymbolId type = SymbolTable::kEmpty;
+    SymbolId underlying = SymbolTable::kEmpty;
+    SymbolId expiry = SymbolTable::kEmpty;
+    SymbolId option_type = SymbolTable::kEmpty;
+    bool active = false;
+
+    double tick_size = 0.0;
+    double step_size = 0.0;
+    double min_size = 0.0;
+    double min_notional = 0.0;
+    double contract_multiplier = 1.0;
+    double contract_size = 0.0;
+    double strike_price = 0.0;
+    double maker_fee = 0.0;
+    double taker_fee = 0.0;
+};
+
+/**
+ * @brief One exchange's instruments as CompactInstrument rows plus their SymbolTable.
+ * Filter by looking the value up once (symbols().find("BTC")) and comparing ids;
+ * an id of SymbolTable::kNotFound matches no row.
+ */
+class CompactCatalog {
+public:
+    CompactCatalog() = default;
+
+    static CompactCatalog from_instruments(const std::vector<Instrument>& instruments);
+
+    /**
+     * @brief Append one instrument, interning its string fields.
+     */
+    void add(const Instrument& instrument);
+
+    size_t size() const { return instruments_.size(); }
+    bool empty() const { return instruments_.empty(); }
+    const CompactInstrument& operator[](size_t i) const { return instruments_[i]; }
+    const std::vector<CompactInstrument>& instruments() const { return instruments_; }
+    const SymbolTable& symbols() const { return symbols_; }
+
+    std::string_view name(SymbolId id) const { return symbols_.name(id); }
+
+    /**
+     * @brief Rebuild a full Instrument (without `info`) from row `i`.
+     */
+    Instrument expand(size_t i) const;
+
+    /**
+     * @brief Rows whose base, quote and type match; an empty string matches anything.
+     */
+    std::vector<size_t> select(std::string_view base, std::string_view quote = {}, std::string_view type = {}) const;
+
+    /**
+     * @brief Heap bytes held by the rows and the symbol table (approximate).
+     */
+    size_t memory_usage() const;
+
+private:
+    SymbolTable symbols_;
+    std::vector<CompactInstrument> instruments_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_COMPACT_INSTRUMENT_HPP
@@ -0,0 +1,62 @@
+#ifndef NCCAPI_DEADLINE_TIMER_HPP
+#define NCCAPI_DEADLINE_TIMER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nccapi {
+
+/**
+ * @brief Runs tasks at wall-clock deadlines (epoch ms) on one background thread.
+ * The thread is started by the first schedule() call and sleeps until the earliest
+ * deadline, so closing bars on time costs no polling. Tasks run outside the timer's
+ * lock and may schedule further tasks, or even release the last owner of the timer.
+ */
+class DeadlineTimer {
+public:
+    DeadlineTimer();
+    ~DeadlineTimer();
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    /**
+     * @brief Run `task` once the system clock reaches `deadline_ms`. Tasks still
+     * pending when the timer is destroyed are discarded.
+     * @return Id of the task for cancel(), 0 if the timer is being destroyed.
+     */
+    uint64_t schedule(int64_t deadline_ms, std::function<void()> task);
+
+    /**
+     * @brief Discard a pending task. Does nothing if it already ran (or is running).
+     */
+    void cancel(uint64_t id);
+
+private:
+    // Shared with the thread, which may outlive the timer when a task destroys it.
+    struct Task {
+        uint64_t id;
+        std::function<void()> run;
+    };
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::multimap<int64_t, Task> tasks;
+        uint64_t next_id = 0;
+        bool stopping = false;
+    };
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;
+    std::thread thread_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_DEADLINE_TIMER_HPP
@@ -0,0 +1,267 @@
+#ifndef NCCAPI_DECIMAL_HPP
+#define NCCAPI_DECIMAL_HPP
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace nccapi {
+
+/**
+ * @brief Parse a decimal number ("0.00010000", "-1.5e-8", "42") as exchanges send it.
+ * Locale-independent and exception-free (std::from_chars). A leading '+' is accepted.
+ * @return true if the whole text is a number; on failure `out` is left untouched.
+ */
+inline bool parse_decimal(std::string_view text, double& out) noexcept {
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    if (text.empty()) return false;
+    double value = 0.0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return false;
+    out = value;
+    return true;
+}
+
+/**
+ * @brief Integer counterpart of parse_decimal (timestamps, counts).
+ * @return true if the whole text is an integer in range; on failure `out` is left untouched.
+ */
+template <typename Int>
+inline bool parse_integer(std::string_view text, Int& out) noexcept {
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    if (text.empty()) return false;
+    Int value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return false;
+    out = value;
+    return true;
+}
+
+/**
+ * @brief parse_decimal for optional fields: empty text succeeds and leaves `out` at its
+ * default; only text that is present but not a number fails.
+ */
+inline bool parse_optional_decimal(std::string_view text, double& out) noexcept {
+    return text.empty() || parse_decimal(text, out);
+}
+
+/**
+ * @brief parse_decimal returning `fallback` when the text is not a number.
+ */
+inline double decimal_or(std::string_view text, double fallback = 0.0) noexcept {
+    parse_decimal(text, fallback);
+    return fallback;
+}
+
+/**
+ * @brief Exact fixed-point decimal: value = mantissa / 10^scale, with 0 <= scale <= 18.
+ * Prices and sizes quoted on an instrument's tick/step grid are represented without
+ * rounding error, and comparison, addition and hashing are integer operations.
+ * Values with different scales compare and hash by value ("1.50" == "1.5").
+ */
+struct Decimal {
+    static constexpr int kMaxScale = 18;
+
+    int64_t mantissa = 0;
+    int scale = 0;
+
+    Decimal() = default;
+    Decimal(int64_t mantissa, int scale) : mantissa(mantissa), scale(scale) {}
+
+    /**
+     * @brief 10^n for 0 <= n <= kMaxScale.
+     */
+    static constexpr int64_t pow10(int n) {
+        int64_t p = 1;
+        for (int i = 0; i < n; ++i) p *= 10;
+        return p;
+    }
+
+    /**
+     * @brief Parse exchange decimal text ("69534.01000000", "-0.5") straight into `scale` digits.
+     * Digits beyond `scale` are rounded half away from zero. Exponent notation goes through
+     * parse_decimal. On failure (not a number, scale out of range, overflow) `out` is left untouched.
+     */
+    static bool parse(std::string_view text, int scale, Decimal& out) noexcept {
+        if (scale < 0 || scale > kMaxScale) return false;
+        if (text.find_first_of("eE") != std::string_view::npos) {
+            double value = 0.0;
+            return parse_decimal(text, value) && from_double(value, scale, out);
+        }
+
+        bool negative = false;
+        if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+            negative = text.front() == '-';
+            text.remove_prefix(1);
+        }
+
+        const int64_t max = std::numeric_limits<int64_t>::max();
+        int64_t mantissa = 0;
+        int digits = 0;      // Fractional digits consumed into the mantissa
+        bool any = false;    // At least one digit seen
+        bool point = false;
+        bool round_up = false;
+        bool rounded = false;
+        for (char c : text) {
+            if (c == '.') {
+                if (point) return false;
+                point = true;
+                continue;
+            }
+            if (c < '0' || c > '9') return false;
+            any = true;
+            int d = c - '0';
+            if (point && digits == scale) {
+                if (!rounded) round_up = d >= 5;
+                rounded = true;
+                continue;
+            }
+            if (mantissa > (max - d) / 10) return false;
+            mantissa = mantissa * 10 + d;
+            if (point) ++digits;
+        }
+        if (!any) return false;
+        for (; digits < scale; ++digits) {
+            if (mantissa > max / 10) return false;
+            mantissa *= 10;
+        }
+        if (round_up) {
+            if (mantissa == max) return false;
+            ++mantissa;
+        }
+        out = Decimal(negative ? -mantissa : mantissa, scale);
+        return true;
+    }
+
+    /**
+     * @brief Nearest value with `scale` digits. Exact for any double that lies on that grid.
+     * @return false if the value is not finite or does not fit.
+     */
+    static bool from_double(double value, int scale, Decimal& out) noexcept {
+        if (scale < 0 || scale > kMaxScale || !std::isfinite(value)) return false;
+        double scaled = std::round(value * static_cast<double>(pow10(scale)));
+        if (std::fabs(scaled) >= 9.2e18) return false;
+        out = Decimal(static_cast<int64_t>(scaled), scale);
+        return true;
+    }
+
+    double to_double() const { return static_cast<double>(mantissa) / static_cast<double>(pow10(scale)); }
+
+    /**
+     * @brief Same value with `new_scale` digits (rounded half away from zero when digits are dropped).
+     * @return false on overflow or an invalid scale; `out` is left untouched.
+     */
+    bool rescale(int new_scale, Decimal& out) const noexcept {
+        if (new_scale < 0 || new_scale > kMaxScale) return false;
+        if (new_scale >= scale) {
+            int64_t factor = pow10(new_scale - scale);
+            if (mantissa > std::numeric_limits<int64_t>::max() / factor ||
+                mantissa < std::numeric_limits<int64_t>::min() / factor) return false;
+            out = Decimal(mantissa * factor, new_scale);
+            return true;
+        }
+        int64_t factor = pow10(scale - new_scale);
+        int64_t q = mantissa / factor;
+        int64_t r = mantissa % factor;
+        if (2 * r >= factor) ++q;
+        else if (-2 * r >= factor) --q;
+        out = Decimal(q, new_scale);
+        return true;
+    }
+
+    /**
+     * @brief Drop trailing zero digits ("1.5000" -> "1.5"): the canonical form used for hashing.
+     */
+    Decimal normalized() const {
+        Decimal d = *this;
+        while (d.scale > 0 && d.mantissa % 10 == 0) {
+            d.mantissa /= 10;
+            --d.scale;
+        }
+        return d;
+    }
+
+    /**
+     * @brief Three-way comparison by value; falls back to doubles only if aligning the scales overflows.
+     */
+    int compare(const Decimal& other) const {
+        Decimal a = *this, b = other;
+        if (a.scale != b.scale) {
+            int common = a.scale > b.scale ? a.scale : b.scale;
+            if (!a.rescale(common, a) || !b.rescale(common, b)) {
+                double x = to_double(), y = other.to_double();
+                return x < y ? -1 : (x > y ? 1 : 0);
+            }
+        }
+        return a.mantissa < b.mantissa ? -1 : (a.mantissa > b.mantissa ? 1 : 0);
+    }
+
+    bool operator==(const Decimal& o) const { return compare(o) == 0; }
+    bool operator!=(const Decimal& o) const { return compare(o) != 0; }
+    bool operator<(const Decimal& o) const { return compare(o) < 0; }
+    bool operator<=(const Decimal& o) const { return compare(o) <= 0; }
+    bool operator>(const Decimal& o) const { return compare(o) > 0; }
+    bool operator>=(const Decimal& o) const { return compare(o) >= 0; }
+
+    /**
+     * @brief Exact sum at the larger of the two scales (no overflow check).
+     */
+    Decimal operator+(const Decimal& o) const {
+        int common = scale > o.scale ? scale : o.scale;
+        return Decimal(mantissa * pow10(common - scale) + o.mantissa * pow10(common - o.scale), common);
+    }
+
+    Decimal operator-(const Decimal& o) const {
+        int common = scale > o.scale ? scale : o.scale;
+        return Decimal(mantissa * pow10(common - scale) - o.mantissa * pow10(common - o.scale), common);
+    }
+
+    Decimal& operator+=(const Decimal& o) { return *this = *this + o; }
+    Decimal& operator-=(const Decimal& o) { return *this = *this - o; }
+
+    /**
+     * @brief Plain decimal text with exactly `scale` fractional digits ("-0.0100").
+     */
+    std::string to_string() const {
+        uint64_t magnitude = mantissa < 0 ? 0 - static_cast<uint64_t>(mantissa) : static_cast<uint64_t>(mantissa);
+        std::string digits = std::to_string(magnitude);
+        if (scale > 0) {
+            if (digits.size() <= static_cast<size_t>(scale)) digits.insert(0, scale - digits.size() + 1, '0');
+            digits.insert(digits.size() - scale, 1, '.');
+        }
+        return mantissa < 0 ? "-" + digits : digits;
+    }
+};
+
+/**
+ * @brief Number of fractional digits of a tick or step size (0.01 -> 2, 0.5 -> 1, 10 -> 0).
+ * @return -1 if the increment is not positive or needs more than Decimal::kMaxScale digits.
+ */
+inline int decimal_places(double increment) {
+    if (!(increment > 0.0) || !std::isfinite(increment)) return -1;
+    for (int s = 0; s <= Decimal::kMaxScale; ++s) {
+        double scaled = increment * static_cast<double>(Decimal::pow10(s));
+        if (std::fabs(scaled - std::round(scaled)) <= 1e-9 * (scaled > 1.0 ? scaled : 1.0)) return s;
+    }
+    return -1;
+}
+
+} // namespace nccapi
+
+namespace std {
+template <>
+struct hash<nccapi::Decimal> {
+    size_t operator()(const nccapi::Decimal& d) const noexcept {
+        nccapi::Decimal n = d.normalized();
+        return std::hash<int64_t>()(n.mantissa) * 31 + static_cast<size_t>(n.scale);
+    }
+};
+} // namespace std
+
+#endif // NCCAPI_DECIMAL_HPP
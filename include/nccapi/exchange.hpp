@@ -5,11 +5,35 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <iostream>
 #include "nccapi/instrument.hpp"
 #include "nccapi/candle.hpp"
+#include "nccapi/fixed_candle.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/ticker_table.hpp"
 
 namespace nccapi {
 
+/**
+ * @brief A failed sub-request of a call the exchange splits into several concurrent
+ * requests (one per OKX instType, Bybit category, Deribit currency/kind, ...). The
+ * results of the other sub-requests are still returned.
+ */
+struct PartialFailure {
+    std::string category;   // The sub-request's parameters, e.g. "instType=OPTION"
+    bool timed_out = false; // true: no response before the deadline; false: error response or unreadable payload
+    std::string reason;
+};
+
+/**
+ * @brief Print `failures` as [WARN] lines: the fallback of the calls that cannot return them.
+ */
+inline void warn_partial_failures(const std::string& exchange, const std::vector<PartialFailure>& failures) {
+    for (const auto& failure : failures) {
+        std::cerr << "[WARN] " << exchange << ": " << failure.category << " failed: " << failure.reason << std::endl;
+    }
+}
+
 /**
  * @brief Abstract base class for all exchanges.
  * Uses Pimpl idiom to hide CCAPI implementation details.
@@ -24,6 +48,15 @@ public:
      */
     virtual std::vector<Instrument> get_instruments() = 0;
 
+    /**
+     * @brief get_instruments, appending every failed sub-request to `failures` instead of
+     * printing it. Exchanges that load their catalog with a single request have no
+     * partial failures: the default forwards to get_instruments().
+     */
+    virtual std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) {
+        return get_instruments();
+    }
+
     /**
      * @brief Get the exchange name.
      */
@@ -44,6 +77,65 @@ public:
         throw std::runtime_error("get_historical_candles not implemented for " + get_name());
     }
 
+    /**
+     * @brief Fixed-point variant of get_historical_candles.
+     * Exchanges decoded by the streaming kline decoder convert the payload's decimal
+     * text directly; the default rounds the double candles onto `scale`, which is
+     * exact whenever the prices lie on the instrument's tick grid. Rows that do not
+     * fit `scale` are dropped.
+     */
+    virtual std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                                  const std::string& timeframe,
+                                                                  int64_t from_date,
+                                                                  int64_t to_date,
+                                                                  const FixedScale& scale) {
+        std::vector<Candle> candles = get_historical_candles(instrument_name, timeframe, from_date, to_date);
+        std::vector<FixedCandle> fixed;
+        fixed.reserve(candles.size());
+        FixedCandle row;
+        for (const auto& candle : candles) {
+            if (FixedCandle::from_candle(candle, scale, row)) fixed.push_back(row);
+        }
+        return fixed;
+    }
+
+    /**
+     * @brief Last price, best bid/ask and 24h volume of every instrument, from the
+     * exchange's all-symbols ticker endpoint: one request (or one concurrent request per
+     * instrument type) for the whole universe.
+     */
+    virtual TickerTable get_tickers() {
+        throw std::runtime_error("get_tickers not implemented for " + get_name());
+    }
+
+    /**
+     * @brief get_tickers, appending every failed sub-request to `failures` instead of
+     * printing it (same contract as get_instruments(failures)).
+     */
+    virtual TickerTable get_tickers(std::vector<PartialFailure>& failures) {
+        return get_tickers();
+    }
+
+    /**
+     * @brief Maximum number of candles a single range request returns.
+     * Used by the Client to split long ranges into pages. 0 means the exchange
+     * ignores from_date/to_date (or has no documented cap), so no pagination.
+     */
+    virtual size_t max_candles_per_request() const { return 0; }
+
+    /**
+     * @brief Candle intervals the exchange serves natively. get_historical_candles throws
+     * std::invalid_argument for any other timeframe; the Client fetches a native divisor
+     * instead and resamples. Empty (the default) means not described: no checks.
+     */
+    virtual TimeframeTable timeframes() const { return {}; }
+
+    /**
+     * @brief False if the exchange has no usable candle websocket: Client::subscribe_candles
+     * then builds the bars from its public trade stream.
+     */
+    virtual bool streams_candles() const { return true; }
+
     // Future generic methods will go here
 };
 
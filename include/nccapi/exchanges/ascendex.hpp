@@ -18,7 +18,9 @@ public:
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    TimeframeTable timeframes() const override;
     std::string get_name() const override { return "ascendex"; }
+    size_t max_candles_per_request() const override { return 500; }
 
 private:
     class Impl;
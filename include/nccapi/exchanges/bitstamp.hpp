@@ -18,6 +18,8 @@ public:
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    TimeframeTable timeframes() const override;
+    bool streams_candles() const override { return false; }
     std::string get_name() const override { return "bitstamp"; }
 
 private:
@@ -14,11 +14,16 @@ public:
     ~Bybit() override;
 
     std::vector<Instrument> get_instruments() override;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) override;
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    TickerTable get_tickers() override;
+    TickerTable get_tickers(std::vector<PartialFailure>& failures) override;
+    TimeframeTable timeframes() const override;
     std::string get_name() const override { return "bybit"; }
+    size_t max_candles_per_request() const override { return 1000; }
 
 private:
     class Impl;
@@ -14,11 +14,19 @@ public:
     ~Deribit() override;
 
     std::vector<Instrument> get_instruments() override;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) override;
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) override;
+    TimeframeTable timeframes() const override;
     std::string get_name() const override { return "deribit"; }
+    size_t max_candles_per_request() const override { return 5000; }
 
 private:
     class Impl;
@@ -18,7 +18,14 @@ public:
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) override;
+    TimeframeTable timeframes() const override;
     std::string get_name() const override { return "huobi-usdt-swap"; }
+    size_t max_candles_per_request() const override { return 2000; }
 
 private:
     class Impl;
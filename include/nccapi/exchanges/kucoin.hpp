@@ -18,7 +18,10 @@ public:
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) override;
+    TickerTable get_tickers() override;
+    TimeframeTable timeframes() const override;
     std::string get_name() const override { return "kucoin"; }
+    size_t max_candles_per_request() const override { return 1500; }
 
 private:
     class Impl;
@@ -0,0 +1,55 @@
+#ifndef NCCAPI_EXECUTOR_HPP
+#define NCCAPI_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nccapi {
+
+/**
+ * @brief Bounded worker pool used to run client calls asynchronously.
+ * Workers are spawned lazily, up to `max_workers`, so a Client that never
+ * uses the async API never starts a thread. Tasks block on the UnifiedSession
+ * router (not on a polling loop), so an idle-waiting worker costs no CPU.
+ */
+class Executor {
+public:
+    explicit Executor(size_t max_workers);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Queue a task. Tasks that have not started when the executor is destroyed
+     * are not run: their `cancel` function (if any) is called instead, on the destroying
+     * thread, so that callers waiting for a completion callback are still answered.
+     */
+    void post(std::function<void()> task, std::function<void()> cancel = nullptr);
+
+    size_t max_workers() const { return max_workers_; }
+
+private:
+    void run();
+
+    struct Task {
+        std::function<void()> run;
+        std::function<void()> cancel;
+    };
+
+    const size_t max_workers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    size_t idle_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_EXECUTOR_HPP
@@ -0,0 +1,204 @@
+#ifndef NCCAPI_FIXED_CANDLE_HPP
+#define NCCAPI_FIXED_CANDLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "nccapi/candle.hpp"
+#include "nccapi/candle_series.hpp"
+#include "nccapi/decimal.hpp"
+#include "nccapi/instrument.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief Number of fractional digits kept for prices and volumes of one instrument.
+ */
+struct FixedScale {
+    int price = 8;   // Digits of the price grid (tick_size 0.01 -> 2)
+    int volume = 8;  // Digits of the quantity grid (step_size 0.00001 -> 5)
+
+    /**
+     * @brief Scales matching the instrument's tick_size and step_size.
+     * A missing or unusable increment keeps the default of 8 digits.
+     */
+    static FixedScale for_instrument(const Instrument& instrument) {
+        FixedScale scale;
+        int price = decimal_places(instrument.tick_size);
+        int volume = decimal_places(instrument.step_size);
+        if (price >= 0) scale.price = price;
+        if (volume >= 0) scale.volume = volume;
+        return scale;
+    }
+};
+
+/**
+ * @brief OHLCV candlestick with fixed-point fields.
+ * Prices are mantissas at FixedScale::price, the volume at FixedScale::volume;
+ * the scale itself is held by the container (FixedCandleSeries) or the caller.
+ */
+struct FixedCandle {
+    uint64_t timestamp = 0; // Timestamp in milliseconds
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t close = 0;
+    int64_t volume = 0;
+
+    /**
+     * @brief Round a floating-point candle onto `scale`.
+     * @return false if a field is not finite or does not fit an int64 mantissa; `out` is left untouched.
+     */
+    static bool from_candle(const Candle& candle, const FixedScale& scale, FixedCandle& out) {
+        Decimal open, high, low, close, volume;
+        if (!Decimal::from_double(candle.open, scale.price, open) || !Decimal::from_double(candle.high, scale.price, high) ||
+            !Decimal::from_double(candle.low, scale.price, low) || !Decimal::from_double(candle.close, scale.price, close) ||
+            !Decimal::from_double(candle.volume, scale.volume, volume)) {
+            return false;
+        }
+        out.timestamp = candle.timestamp;
+        out.open = open.mantissa;
+        out.high = high.mantissa;
+        out.low = low.mantissa;
+        out.close = close.mantissa;
+        out.volume = volume.mantissa;
+        return true;
+    }
+
+    Candle to_candle(const FixedScale& scale) const {
+        Candle candle;
+        candle.timestamp = timestamp;
+        candle.open = Decimal(open, scale.price).to_double();
+        candle.high = Decimal(high, scale.price).to_double();
+        candle.low = Decimal(low, scale.price).to_double();
+        candle.close = Decimal(close, scale.price).to_double();
+        candle.volume = Decimal(volume, scale.volume).to_double();
+        return candle;
+    }
+
+    bool operator==(const FixedCandle& o) const {
+        return timestamp == o.timestamp && open == o.open && high == o.high &&
+               low == o.low && close == o.close && volume == o.volume;
+    }
+    bool operator!=(const FixedCandle& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Columnar series of FixedCandle sharing one FixedScale.
+ * Same layout as CandleSeries (64-byte aligned arrays), with int64 mantissas
+ * instead of doubles: aggregates over a column are exact integer sums.
+ */
+class FixedCandleSeries {
+public:
+    template <typename T>
+    using Column = std::vector<T, AlignedAllocator<T>>;
+
+    FixedCandleSeries() = default;
+    explicit FixedCandleSeries(const FixedScale& scale) : scale_(scale) {}
+
+    const FixedScale& scale() const { return scale_; }
+    size_t size() const { return timestamp_.size(); }
+    bool empty() const { return timestamp_.empty(); }
+
+    void reserve(size_t n) {
+        timestamp_.reserve(n);
+        open_.reserve(n);
+        high_.reserve(n);
+        low_.reserve(n);
+        close_.reserve(n);
+        volume_.reserve(n);
+    }
+
+    void clear() {
+        timestamp_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+    }
+
+    /**
+     * @brief Append a row whose mantissas are already at scale().
+     */
+    void push_back(const FixedCandle& candle) {
+        timestamp_.push_back(candle.timestamp);
+        open_.push_back(candle.open);
+        high_.push_back(candle.high);
+        low_.push_back(candle.low);
+        close_.push_back(candle.close);
+        volume_.push_back(candle.volume);
+    }
+
+    /**
+     * @brief Append a floating-point row, rounded onto scale().
+     * @return false (nothing appended) if the row does not fit the scale, see FixedCandle::from_candle.
+     */
+    bool push_back(const Candle& candle) {
+        FixedCandle fixed;
+        if (!FixedCandle::from_candle(candle, scale_, fixed)) return false;
+        push_back(fixed);
+        return true;
+    }
+
+    FixedCandle operator[](size_t i) const {
+        FixedCandle candle;
+        candle.timestamp = timestamp_[i];
+        candle.open = open_[i];
+        candle.high = high_[i];
+        candle.low = low_[i];
+        candle.close = close_[i];
+        candle.volume = volume_[i];
+        return candle;
+    }
+
+    Decimal open(size_t i) const { return Decimal(open_[i], scale_.price); }
+    Decimal high(size_t i) const { return Decimal(high_[i], scale_.price); }
+    Decimal low(size_t i) const { return Decimal(low_[i], scale_.price); }
+    Decimal close(size_t i) const { return Decimal(close_[i], scale_.price); }
+    Decimal volume(size_t i) const { return Decimal(volume_[i], scale_.volume); }
+
+    const uint64_t* timestamps() const { return timestamp_.data(); }
+    const int64_t* opens() const { return open_.data(); }
+    const int64_t* highs() const { return high_.data(); }
+    const int64_t* lows() const { return low_.data(); }
+    const int64_t* closes() const { return close_.data(); }
+    const int64_t* volumes() const { return volume_.data(); }
+
+    /**
+     * @brief Rows that do not fit `scale` (non-finite or overflowing) are skipped.
+     */
+    static FixedCandleSeries from_candles(const std::vector<Candle>& candles, const FixedScale& scale) {
+        FixedCandleSeries series(scale);
+        series.reserve(candles.size());
+        for (const auto& candle : candles) series.push_back(candle);
+        return series;
+    }
+
+    static FixedCandleSeries from_candles(const std::vector<FixedCandle>& candles, const FixedScale& scale) {
+        FixedCandleSeries series(scale);
+        series.reserve(candles.size());
+        for (const auto& candle : candles) series.push_back(candle);
+        return series;
+    }
+
+    std::vector<Candle> to_candles() const {
+        std::vector<Candle> candles;
+        candles.reserve(size());
+        for (size_t i = 0; i < size(); ++i) candles.push_back((*this)[i].to_candle(scale_));
+        return candles;
+    }
+
+private:
+    FixedScale scale_;
+    Column<uint64_t> timestamp_;
+    Column<int64_t> open_;
+    Column<int64_t> high_;
+    Column<int64_t> low_;
+    Column<int64_t> close_;
+    Column<int64_t> volume_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_FIXED_CANDLE_HPP
@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <sstream>
+#include "nccapi/instrument_info.hpp"
 
 namespace nccapi {
 
@@ -20,8 +21,8 @@ struct Instrument {
     std::string type;           // spot, future, option, swap
     bool active = false;        // Trading status
 
-    double tick_size = 0.0;     // Price increment
-    double step_size = 0.0;     // Quantity increment
+    double tick_size = 0.0;     // Price increment (0 if the exchange does not report it)
+    double step_size = 0.0;     // Quantity increment (0 if the exchange does not report it)
     double min_size = 0.0;      // Minimum quantity
     double min_notional = 0.0;  // Minimum notional value (price * qty)
 
@@ -38,7 +39,7 @@ struct Instrument {
     double maker_fee = 0.0;
     double taker_fee = 0.0;
 
-    std::map<std::string, std::string> info; // Raw exchange info
+    InstrumentInfo info;        // Raw exchange info (see InfoMode)
 
     std::string toString() const {
         std::stringstream ss;
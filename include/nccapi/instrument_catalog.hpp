@@ -0,0 +1,91 @@
+#ifndef NCCAPI_INSTRUMENT_CATALOG_HPP
+#define NCCAPI_INSTRUMENT_CATALOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "nccapi/instrument.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief One exchange's instruments with lookup indexes.
+ * - Hash indexes on `id` and `symbol`: find_by_id / find_by_symbol are O(1).
+ * - Secondary hash indexes on base, quote, type and settle.
+ * - Sorted, case-insensitive key lists on id and symbol for prefix search.
+ * The catalog is immutable once built; share it across threads freely.
+ */
+class InstrumentCatalog {
+public:
+    InstrumentCatalog() = default;
+    explicit InstrumentCatalog(std::vector<Instrument> instruments);
+    InstrumentCatalog(const InstrumentCatalog& other);
+    InstrumentCatalog(InstrumentCatalog&& other) noexcept = default;
+    InstrumentCatalog& operator=(const InstrumentCatalog& other);
+    InstrumentCatalog& operator=(InstrumentCatalog&& other) noexcept = default;
+
+    size_t size() const { return instruments_.size(); }
+    bool empty() const { return instruments_.empty(); }
+    const Instrument& operator[](size_t i) const { return instruments_[i]; }
+    std::vector<Instrument>::const_iterator begin() const { return instruments_.begin(); }
+    std::vector<Instrument>::const_iterator end() const { return instruments_.end(); }
+    const std::vector<Instrument>& instruments() const { return instruments_; }
+
+    /**
+     * @brief Exact lookups; nullptr if absent. On duplicate keys the first instrument wins.
+     */
+    const Instrument* find_by_id(std::string_view id) const;
+    const Instrument* find_by_symbol(std::string_view symbol) const;
+
+    /**
+     * @brief find_by_id, then find_by_symbol.
+     */
+    const Instrument* find(std::string_view id_or_symbol) const;
+
+    /**
+     * @brief Instruments with the given field value, in catalog order.
+     */
+    std::vector<const Instrument*> by_base(std::string_view base) const { return lookup(by_base_, base); }
+    std::vector<const Instrument*> by_quote(std::string_view quote) const { return lookup(by_quote_, quote); }
+    std::vector<const Instrument*> by_type(std::string_view type) const { return lookup(by_type_, type); }
+    std::vector<const Instrument*> by_settle(std::string_view settle) const { return lookup(by_settle_, settle); }
+
+    /**
+     * @brief Instruments matching every non-empty filter, in catalog order.
+     * Starts from the smallest matching index, so the cost follows the result, not the catalog.
+     */
+    std::vector<const Instrument*> select(std::string_view base,
+                                          std::string_view quote = {},
+                                          std::string_view type = {},
+                                          std::string_view settle = {}) const;
+
+    /**
+     * @brief Instruments whose id or symbol starts with `prefix` (ASCII case-insensitive),
+     * ordered by key, each instrument at most once. `limit` 0 means no limit.
+     */
+    std::vector<const Instrument*> with_prefix(std::string_view prefix, size_t limit = 0) const;
+
+private:
+    using Index = std::unordered_map<std::string_view, std::vector<uint32_t>>;
+
+    void build();
+    std::vector<const Instrument*> lookup(const Index& index, std::string_view key) const;
+
+    std::vector<Instrument> instruments_;
+    // Keys are views into instruments_ (stable: the vector is never modified after build()).
+    std::unordered_map<std::string_view, uint32_t> by_id_;
+    std::unordered_map<std::string_view, uint32_t> by_symbol_;
+    Index by_base_;
+    Index by_quote_;
+    Index by_type_;
+    Index by_settle_;
+    std::vector<std::pair<std::string, uint32_t>> prefix_keys_; // Upper-cased id and symbol, sorted
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_INSTRUMENT_CATALOG_HPP
@@ -0,0 +1,210 @@
+#ifndef NCCAPI_INSTRUMENT_INFO_HPP
+#define NCCAPI_INSTRUMENT_INFO_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "nccapi/symbol_table.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief How get_instruments keeps the raw exchange fields of each instrument (Instrument::info).
+ */
+enum class InfoMode {
+    Eager, // Copy every key/value into a std::map per instrument (default)
+    Lazy,  // Keep them in one arena shared by the whole catalog; decode a map on first access
+    Skip   // Do not keep them: info stays empty
+};
+
+/**
+ * @brief Raw key/value storage shared by the instruments of one catalog.
+ * Keys are interned (they repeat on every row), values are packed into one string.
+ */
+struct InfoArena {
+    struct Entry {
+        SymbolId key;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    SymbolTable keys;
+    std::string values;
+    std::vector<Entry> entries;
+
+    void append(SymbolId key, std::string_view value) {
+        entries.push_back(Entry{key, static_cast<uint32_t>(values.size()), static_cast<uint32_t>(value.size())});
+        values.append(value.data(), value.size());
+    }
+
+    /**
+     * @brief Point entries[index] at a new value (the old bytes stay unused in `values`).
+     */
+    void replace(size_t index, std::string_view value) {
+        entries[index].offset = static_cast<uint32_t>(values.size());
+        entries[index].length = static_cast<uint32_t>(value.size());
+        values.append(value.data(), value.size());
+    }
+};
+
+/**
+ * @brief Instrument::info: the raw exchange fields as a std::map-like container.
+ * In InfoMode::Lazy the pairs live in a shared InfoArena, so copying an Instrument
+ * copies a pointer; the map is only decoded on the first call that needs it
+ * (lookup, iteration, modification). size() and for_each() never decode.
+ * Concurrent const access to one instance is safe, as for a std::map.
+ */
+class InstrumentInfo {
+public:
+    using Map = std::map<std::string, std::string>;
+    using iterator = Map::iterator;
+    using const_iterator = Map::const_iterator;
+
+    InstrumentInfo() = default;
+    InstrumentInfo(const InstrumentInfo& other);
+    InstrumentInfo(InstrumentInfo&& other) noexcept;
+    InstrumentInfo& operator=(const InstrumentInfo& other);
+    InstrumentInfo& operator=(InstrumentInfo&& other) noexcept;
+
+    std::string& operator[](const std::string& key) { return map()[key]; }
+    const std::string& at(const std::string& key) const { return map().at(key); }
+    iterator find(const std::string& key) { return map().find(key); }
+    const_iterator find(const std::string& key) const { return map().find(key); }
+    size_t count(const std::string& key) const { return map().count(key); }
+
+    iterator begin() { return map().begin(); }
+    iterator end() { return map().end(); }
+    const_iterator begin() const { return map().begin(); }
+    const_iterator end() const { return map().end(); }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return map().emplace_hint(hint, std::forward<Args>(args)...);
+    }
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    void clear();
+
+    /**
+     * @brief The decoded map (decoded now if still raw).
+     */
+    Map& map();
+    const Map& map() const;
+
+    /**
+     * @brief True once the pairs are held in the std::map (always, outside InfoMode::Lazy).
+     */
+    bool decoded() const { return decoded_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Visit every (key, value) as string_views, without decoding a lazy map.
+     */
+    template <typename F>
+    void for_each(F&& f) const {
+        if (decoded()) {
+            for (const auto& entry : map_) f(std::string_view(entry.first), std::string_view(entry.second));
+            return;
+        }
+        for (uint32_t i = first_; i < first_ + count_; ++i) {
+            const InfoArena::Entry& entry = arena_->entries[i];
+            f(arena_->keys.name(entry.key), std::string_view(arena_->values).substr(entry.offset, entry.length));
+        }
+    }
+
+    /**
+     * @brief Point at `count` entries of `arena` starting at `first` (InfoMode::Lazy).
+     * The entries must have distinct keys: size() counts them without decoding.
+     */
+    void assign_raw(std::shared_ptr<const InfoArena> arena, uint32_t first, uint32_t count);
+
+private:
+    void decode() const;
+
+    mutable Map map_;
+    mutable std::atomic<bool> decoded_{true};
+    std::shared_ptr<const InfoArena> arena_;
+    uint32_t first_ = 0;
+    uint32_t count_ = 0;
+};
+
+/**
+ * @brief Fills Instrument::info according to an InfoMode while a catalog is decoded.
+ * One collector per get_instruments call: in InfoMode::Lazy all instruments it
+ * fills share its arena.
+ */
+class InfoCollector {
+public:
+    explicit InfoCollector(InfoMode mode) : mode_(mode) {
+        if (mode_ == InfoMode::Lazy) arena_ = std::make_shared<InfoArena>();
+    }
+
+    InfoMode mode() const { return mode_; }
+
+    /**
+     * @brief Expect `rows` more instruments: in InfoMode::Lazy the arena is sized from the
+     * first of them, so it is not regrown row after row.
+     */
+    void reserve(size_t rows) {
+        if (arena_) pending_rows_ += rows;
+    }
+
+    /**
+     * @brief Store `pairs` (any range of key/value pairs convertible to string_view) as `info`.
+     * A key repeated within `pairs` keeps its last value in every mode.
+     */
+    template <typename Pairs>
+    void assign(InstrumentInfo& info, const Pairs& pairs) {
+        if (mode_ == InfoMode::Skip) return;
+        if (mode_ == InfoMode::Eager) {
+            for (const auto& pair : pairs) {
+                std::string_view key(pair.first);
+                std::string_view value(pair.second);
+                info[std::string(key)] = std::string(value);
+            }
+            return;
+        }
+        uint32_t first = static_cast<uint32_t>(arena_->entries.size());
+        size_t bytes = arena_->values.size();
+        ++row_;
+        for (const auto& pair : pairs) {
+            SymbolId key = arena_->keys.intern(std::string_view(pair.first));
+            if (key >= key_row_.size()) {
+                key_row_.resize(key + 1, 0);
+                key_entry_.resize(key + 1, 0);
+            }
+            if (key_row_[key] == row_) {
+                arena_->replace(key_entry_[key], std::string_view(pair.second));
+                continue;
+            }
+            key_row_[key] = row_;
+            key_entry_[key] = static_cast<uint32_t>(arena_->entries.size());
+            arena_->append(key, std::string_view(pair.second));
+        }
+        if (pending_rows_ > 0) {
+            size_t rows = pending_rows_;
+            pending_rows_ = 0;
+            arena_->entries.reserve(arena_->entries.size() + (arena_->entries.size() - first) * rows);
+            arena_->values.reserve(arena_->values.size() + (arena_->values.size() - bytes) * rows);
+        }
+        info.assign_raw(arena_, first, static_cast<uint32_t>(arena_->entries.size()) - first);
+    }
+
+private:
+    InfoMode mode_;
+    std::shared_ptr<InfoArena> arena_;
+    size_t pending_rows_ = 0;
+    // InfoMode::Lazy: last row each key id appeared in, and its entry there (repeated keys).
+    uint32_t row_ = 0;
+    std::vector<uint32_t> key_row_;
+    std::vector<uint32_t> key_entry_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_INSTRUMENT_INFO_HPP
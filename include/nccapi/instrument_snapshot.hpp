@@ -0,0 +1,41 @@
+#ifndef NCCAPI_INSTRUMENT_SNAPSHOT_HPP
+#define NCCAPI_INSTRUMENT_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "nccapi/instrument.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief Binary snapshot of one exchange's instrument catalog.
+ *
+ * File layout (native endianness, strings are uint32 length + bytes):
+ *   char[4]  magic "NCI1"
+ *   int64    fetched_at (ms since epoch)
+ *   uint64   instrument count, then every Instrument field in declaration order,
+ *            `active` as one byte and `info` as uint32 count + key/value strings
+ */
+struct InstrumentSnapshot {
+    int64_t fetched_at = 0;
+    std::vector<Instrument> instruments;
+};
+
+/**
+ * @brief Write `snapshot` to `path` (via a temporary file, so readers never see a partial file).
+ * @return false if the file could not be written.
+ */
+bool write_instrument_snapshot(const std::string& path, const InstrumentSnapshot& snapshot);
+
+/**
+ * @brief Read a snapshot written by write_instrument_snapshot.
+ * `info_mode` chooses how Instrument::info is restored (InfoMode::Lazy shares one arena).
+ * @return false if the file is missing, truncated or has an unknown format.
+ */
+bool read_instrument_snapshot(const std::string& path, InstrumentSnapshot& snapshot,
+                              InfoMode info_mode = InfoMode::Eager);
+
+} // namespace nccapi
+
+#endif // NCCAPI_INSTRUMENT_SNAPSHOT_HPP
@@ -0,0 +1,120 @@
+#ifndef NCCAPI_ORDER_BOOK_HPP
+#define NCCAPI_ORDER_BOOK_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace nccapi {
+
+/**
+ * @brief L2 order book kept in flat sorted arrays instead of node-based maps.
+ * Each side is a struct of arrays: integer price keys (prices in ticks of the
+ * instrument's tick_size) and level quantities, ordered so that the best level is
+ * last. Updates mostly touch the top of the book, so they only shift the few levels
+ * above the one changed, and a lookup first tries the slot a dense book would put
+ * the price in (best minus the distance in ticks) before a binary search.
+ */
+class OrderBook {
+public:
+    enum class Side { Bid, Ask };
+
+    /**
+     * @brief Read-only view of the levels of one side, best first. It points into the
+     * book: no copy is made, and it is invalidated by the next update.
+     */
+    class Levels {
+    public:
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        int64_t ticks(size_t i) const { return sign_ * keys_[last_ - i]; }
+        double price(size_t i) const { return book_->to_price(ticks(i)); }
+        double quantity(size_t i) const { return quantities_[last_ - i]; }
+
+    private:
+        friend class OrderBook;
+        const OrderBook* book_ = nullptr;
+        const int64_t* keys_ = nullptr;
+        const double* quantities_ = nullptr;
+        size_t last_ = 0;
+        size_t count_ = 0;
+        int64_t sign_ = 1;
+    };
+
+    /**
+     * @param tick_size Price increment (Instrument::tick_size); 0 uses a 1e-8 grid.
+     * @param max_depth Levels exposed per side; 0 keeps every level pushed. Worse levels
+     * are dropped, so the feed has to resend those moving back into the top max_depth
+     * (ccapi's MARKET_DEPTH_MAX updates do).
+     */
+    explicit OrderBook(double tick_size = 0.0, size_t max_depth = 0);
+
+    double tick_size() const { return tick_size_; }
+    int64_t to_ticks(double price) const { return std::llround(price * ticks_per_unit_); }
+    double to_price(int64_t ticks) const {
+        // Dividing by an integral ticks_per_unit_ gives the closest double ("0.1", not "0.1000000000000001").
+        return tick_size_ < 1.0 ? static_cast<double>(ticks) / ticks_per_unit_ : static_cast<double>(ticks) * tick_size_;
+    }
+
+    /**
+     * @brief Set the quantity of a level; a quantity of 0 removes it.
+     */
+    void set(Side side, double price, double quantity) { set_ticks(side, to_ticks(price), quantity); }
+    void set_ticks(Side side, int64_t ticks, double quantity);
+
+    void clear();
+
+    Levels bids(size_t depth = std::numeric_limits<size_t>::max()) const { return view(bids_, 1, depth); }
+    Levels asks(size_t depth = std::numeric_limits<size_t>::max()) const { return view(asks_, -1, depth); }
+
+    /**
+     * @brief Time of the last update applied (ms), as stamped by the exchange.
+     */
+    uint64_t timestamp() const { return timestamp_; }
+    void set_timestamp(uint64_t timestamp) { timestamp_ = timestamp; }
+
+private:
+    // Keys ascend towards the best level: ticks for bids, negated ticks for asks.
+    struct BookSide {
+        std::vector<int64_t> keys;
+        std::vector<double> quantities;
+    };
+
+    void set_key(BookSide& side, int64_t key, double quantity);
+    Levels view(const BookSide& side, int64_t sign, size_t depth) const;
+
+    double tick_size_;
+    double ticks_per_unit_;
+    size_t max_depth_;
+    BookSide bids_;
+    BookSide asks_;
+    uint64_t timestamp_ = 0;
+};
+
+/**
+ * @brief One order book update. `book` is the whole book after the update; it and its
+ * views are only valid during the handler call. `snapshot` is true when the book was
+ * rebuilt from a full snapshot (after a reconnection), and on the first update a
+ * handler receives.
+ * The string views stay valid until the subscription is cancelled or destroyed.
+ */
+struct OrderBookUpdate {
+    std::string_view exchange;
+    std::string_view instrument;
+    const OrderBook& book;
+    bool snapshot;
+};
+
+/**
+ * @brief Receives OrderBookUpdates on the session's event thread: keep it short, and
+ * copy out what is needed (e.g. the top levels) rather than keeping the book.
+ */
+using OrderBookHandler = std::function<void(const OrderBookUpdate&)>;
+
+} // namespace nccapi
+
+#endif // NCCAPI_ORDER_BOOK_HPP
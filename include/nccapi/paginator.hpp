@@ -0,0 +1,71 @@
+#ifndef NCCAPI_PAGINATOR_HPP
+#define NCCAPI_PAGINATOR_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "nccapi/exchange.hpp"
+#include "nccapi/candle.hpp"
+#include "nccapi/candle_series.hpp"
+#include "nccapi/fixed_candle.hpp"
+
+namespace nccapi {
+
+class Executor;
+
+/**
+ * @brief Duration of one candle in milliseconds ("1m" -> 60000, "1M" -> 30 days).
+ * @return 0 if the timeframe is not recognised.
+ */
+int64_t timeframe_to_ms(const std::string& timeframe);
+
+/**
+ * @brief Fetch [from_date, to_date] as a series of range requests sized for the exchange.
+ * The range is cut into pages of exchange.max_candles_per_request() candles; up to
+ * `max_in_flight` pages are requested concurrently. Each page is sorted and appended in
+ * time order, deduplicated by timestamp, as soon as every earlier page has arrived, then
+ * freed; a page is only requested while fewer than `max_in_flight` pages are waiting to
+ * be appended. An unpaginated result is sorted and
+ * deduplicated too, so every path returns the same rows. The first page error is rethrown.
+ * The calling thread fetches pages itself while helpers posted to `executor` (the
+ * Client's worker pool) fetch the others. It never waits for a helper that has not
+ * started, so a paginated call issued from an async task cannot starve the pool it runs on.
+ */
+std::vector<Candle> fetch_candles_paginated(Exchange& exchange,
+                                            const std::string& instrument_name,
+                                            const std::string& timeframe,
+                                            int64_t from_date,
+                                            int64_t to_date,
+                                            Executor& executor,
+                                            size_t max_in_flight);
+
+/**
+ * @brief Same rows as fetch_candles_paginated, stitched into a columnar CandleSeries.
+ * Pages are still decoded as std::vector<Candle>. The series is reserved once for every
+ * candle open time in the range, so the peak is that series plus at most
+ * `max_in_flight` decoded pages.
+ */
+CandleSeries fetch_candle_series_paginated(Exchange& exchange,
+                                           const std::string& instrument_name,
+                                           const std::string& timeframe,
+                                           int64_t from_date,
+                                           int64_t to_date,
+                                           Executor& executor,
+                                           size_t max_in_flight);
+
+/**
+ * @brief Fixed-point counterpart of fetch_candle_series_paginated: pages come from
+ * Exchange::get_historical_fixed_candles at `scale`.
+ */
+FixedCandleSeries fetch_fixed_series_paginated(Exchange& exchange,
+                                               const std::string& instrument_name,
+                                               const std::string& timeframe,
+                                               int64_t from_date,
+                                               int64_t to_date,
+                                               const FixedScale& scale,
+                                               Executor& executor,
+                                               size_t max_in_flight);
+
+} // namespace nccapi
+
+#endif // NCCAPI_PAGINATOR_HPP
@@ -0,0 +1,28 @@
+#ifndef NCCAPI_RATE_LIMIT_HPP
+#define NCCAPI_RATE_LIMIT_HPP
+
+#include <map>
+#include <string>
+
+namespace nccapi {
+
+/**
+ * @brief Token-bucket limit applied to every request sent to one exchange.
+ * The bucket holds up to `burst` tokens and refills at `requests_per_second`.
+ * A request consumes its weight in tokens; when the bucket is short it is queued
+ * (not rejected) and sent as soon as enough tokens have accumulated.
+ */
+struct RateLimit {
+    double requests_per_second = 0.0;      // Sustained refill rate; <= 0 disables limiting
+    double burst = 1.0;                    // Bucket capacity (requests that may go out back to back)
+    std::map<std::string, double> weights; // HTTP path -> tokens consumed (default 1)
+};
+
+/**
+ * @brief Built-in public-endpoint limits, kept below each exchange's documented per-IP quota.
+ */
+std::map<std::string, RateLimit> default_rate_limits();
+
+} // namespace nccapi
+
+#endif // NCCAPI_RATE_LIMIT_HPP
@@ -0,0 +1,294 @@
+#ifndef NCCAPI_RING_BUFFER_HPP
+#define NCCAPI_RING_BUFFER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace nccapi {
+
+/**
+ * @brief How a Channel consumer waits for the next record.
+ */
+enum class WaitStrategy {
+    BusySpin, // Spin on the ring: lowest latency, burns a core
+    Yield,    // Spin, yielding the time slice between checks
+    Blocking  // Sleep on a condition variable; producers only signal a sleeping consumer
+};
+
+namespace detail {
+    constexpr size_t kCacheLine = 64;
+
+    inline size_t ring_capacity(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+}
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer ring of preallocated slots.
+ * The capacity is rounded up to a power of two. Records are copied into and out of
+ * the slots, so pushing and popping never allocate; T must be trivially copyable.
+ * Each side keeps a cached copy of the other side's index and only reloads it when
+ * the ring looks full (producer) or empty (consumer), and the two indexes live on
+ * separate cache lines.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "ring records must be trivially copyable");
+
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(detail::ring_capacity(capacity) - 1), slots_(new T[mask_ + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Producer side. Returns false if the ring is full.
+     */
+    bool try_push(const T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) return false;
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Returns false if the ring is empty.
+     */
+    bool try_pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        out = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    alignas(detail::kCacheLine) std::atomic<size_t> head_{0}; // Next slot to pop (written by the consumer)
+    size_t tail_cache_ = 0;                                    // Consumer's view of tail_
+    alignas(detail::kCacheLine) std::atomic<size_t> tail_{0}; // Next slot to push (written by the producer)
+    size_t head_cache_ = 0;                                    // Producer's view of head_
+};
+
+/**
+ * @brief Bounded lock-free multi-producer / single-consumer ring of preallocated slots.
+ * Producers claim a slot with one compare-and-swap on the tail and publish it through
+ * the slot's sequence number (Vyukov's bounded queue), so a slow producer never
+ * exposes a half-written record. Same capacity and record rules as SpscRing.
+ */
+template <typename T>
+class MpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "ring records must be trivially copyable");
+
+public:
+    explicit MpscRing(size_t capacity)
+        : mask_(detail::ring_capacity(capacity) - 1), slots_(new Slot[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Producer side, safe from any number of threads. Returns false if the ring is full.
+     */
+    bool try_push(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[tail & mask_];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - tail);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // The consumer has not freed this slot yet: full
+            } else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->sequence.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side (one thread). Returns false if the ring is empty.
+     */
+    bool try_pop(T& out) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = slot.value;
+        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    bool empty() const {
+        return slots_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(detail::kCacheLine) std::atomic<size_t> tail_{0}; // Shared by the producers
+    alignas(detail::kCacheLine) size_t head_ = 0;              // Consumer only
+};
+
+/**
+ * @brief Hands streaming records (CandleUpdate, Trade, ...) from the session's event
+ * thread to a consumer thread through a bounded ring. SpscRing (the default) serves
+ * one subscription per channel: a subscription never delivers concurrently. Use
+ * MpscRing when several subscriptions feed one consumer, since trade-built candles are
+ * also closed from the timer thread.
+ * push() never blocks or allocates: when the ring is full the record is dropped and
+ * counted, so a slow consumer cannot stall the event thread. The consumer waits
+ * according to its WaitStrategy. The exchange / instrument views of a queued record
+ * point into its subscription and dangle once it is cancelled: close() the channel and
+ * drain it before cancelling.
+ *
+ * @code
+ * nccapi::Channel<nccapi::CandleUpdate> channel(4096, nccapi::WaitStrategy::Yield);
+ * auto subscription = client.subscribe_candles("binance", "BTCUSDT", "1m", channel.producer());
+ * nccapi::CandleUpdate update;
+ * while (channel.pop(update)) { ... }   // on the consumer thread, until close()
+ * @endcode
+ */
+template <typename T, template <typename> class Ring = SpscRing>
+class Channel {
+public:
+    explicit Channel(size_t capacity, WaitStrategy wait = WaitStrategy::Yield) : ring_(capacity), wait_(wait) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    size_t capacity() const { return ring_.capacity(); }
+    WaitStrategy wait_strategy() const { return wait_; }
+
+    /**
+     * @brief Producer side. Returns false (and counts the record as dropped) if the ring
+     * is full or the channel closed.
+     */
+    bool push(const T& value) {
+        if (closed_.load(std::memory_order_relaxed) || !ring_.try_push(value)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (wait_ == WaitStrategy::Blocking) wake();
+        return true;
+    }
+
+    /**
+     * @brief A handler pushing every record into this channel, to pass to a
+     * Client::subscribe_* call. The channel must outlive the subscription.
+     */
+    std::function<void(const T&)> producer() {
+        return [this](const T& value) { push(value); };
+    }
+
+    /**
+     * @brief Consumer side: wait for the next record. Returns false once the channel is
+     * closed and every record pushed before close() has been popped.
+     */
+    bool pop(T& out) {
+        while (true) {
+            if (ring_.try_pop(out)) return true;
+            if (closed_.load(std::memory_order_acquire)) return ring_.try_pop(out);
+            switch (wait_) {
+                case WaitStrategy::BusySpin: detail::cpu_relax(); break;
+                case WaitStrategy::Yield: std::this_thread::yield(); break;
+                case WaitStrategy::Blocking: sleep(); break;
+            }
+        }
+    }
+
+    /**
+     * @brief Consumer side: pop without waiting.
+     */
+    bool try_pop(T& out) { return ring_.try_pop(out); }
+
+    /**
+     * @brief Stop accepting records and wake the consumer; pop() drains what is left.
+     */
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Records rejected by push() because the ring was full or the channel closed.
+     */
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    // The consumer announces it is about to sleep, then checks the ring again; the
+    // producer publishes, then checks the announcement. The fences order the two
+    // (store, load) pairs, so one of them always sees the other: no lost wake-up, and
+    // no lock or syscall on the producer side while the consumer is busy.
+    void sleep() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring_.empty() && !closed_.load(std::memory_order_relaxed)) cv_.wait(lock);
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!sleeping_.load(std::memory_order_relaxed)) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+
+    Ring<T> ring_;
+    const WaitStrategy wait_;
+    alignas(detail::kCacheLine) std::atomic<bool> sleeping_{false};
+    std::atomic<bool> closed_{false};
+    std::atomic<uint64_t> dropped_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_RING_BUFFER_HPP
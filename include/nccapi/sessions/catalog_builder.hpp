@@ -0,0 +1,81 @@
+#ifndef NCCAPI_CATALOG_BUILDER_HPP
+#define NCCAPI_CATALOG_BUILDER_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "nccapi/instrument.hpp"
+#include "nccapi/instrument_info.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief Accumulates the instruments of one get_instruments call with as few allocations as possible.
+ * - reserve() sizes the result from the response (element or array count) before decoding;
+ * - emplace() constructs each record in place, so nothing is copied into the result;
+ * - Instrument::info goes through one InfoCollector (one shared arena in InfoMode::Lazy);
+ * - row_scratch() hands out a monotonic resource over an inline buffer for per-row
+ *   temporaries (e.g. the key/value list fed to assign_info), so rows do not hit the heap.
+ */
+class CatalogBuilder {
+public:
+    explicit CatalogBuilder(InfoMode mode) : info_(mode) {}
+
+    CatalogBuilder(const CatalogBuilder&) = delete;
+    CatalogBuilder& operator=(const CatalogBuilder&) = delete;
+
+    /**
+     * @brief Make room for `additional` more instruments.
+     */
+    void reserve(size_t additional) {
+        instruments_.reserve(instruments_.size() + additional);
+        info_.reserve(additional);
+    }
+
+    /**
+     * @brief Append a default-constructed instrument and return it for filling.
+     * The reference is valid until the next emplace() or finish().
+     */
+    Instrument& emplace() { return instruments_.emplace_back(); }
+
+    /**
+     * @brief Drop the instrument returned by the last emplace() (a malformed row).
+     * Call it before assign_info().
+     */
+    void discard() { instruments_.pop_back(); }
+
+    template <typename Pairs>
+    void assign_info(Instrument& instrument, const Pairs& pairs) { info_.assign(instrument.info, pairs); }
+
+    InfoMode info_mode() const { return info_.mode(); }
+
+    /**
+     * @brief A fresh resource over the builder's scratch buffer (heap beyond it).
+     * Declare it before the containers using it; one live at a time.
+     */
+    std::pmr::monotonic_buffer_resource row_scratch() {
+        return std::pmr::monotonic_buffer_resource(scratch_, sizeof(scratch_));
+    }
+
+    size_t size() const { return instruments_.size(); }
+
+    /**
+     * @brief The accumulated instruments (moved out; the builder is empty afterwards).
+     */
+    std::vector<Instrument> finish() {
+        std::vector<Instrument> result = std::move(instruments_);
+        instruments_.clear();
+        return result;
+    }
+
+private:
+    std::vector<Instrument> instruments_;
+    InfoCollector info_;
+    alignas(std::max_align_t) char scratch_[16 * 1024];
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_CATALOG_BUILDER_HPP
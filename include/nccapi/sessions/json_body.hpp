@@ -0,0 +1,38 @@
+#ifndef NCCAPI_JSON_BODY_HPP
+#define NCCAPI_JSON_BODY_HPP
+
+#include <string>
+
+#include "ccapi_cpp/ccapi_element.h"
+#include "rapidjson/document.h"
+
+namespace nccapi {
+
+/**
+ * @brief Parse a JSON response body in situ, using storage owned by the calling thread.
+ * The body is copied once into a per-thread buffer whose capacity survives between calls,
+ * and parsed in place, so string values point into that buffer instead of being duplicated.
+ * DOM nodes come from a per-thread MemoryPoolAllocator that is rewound, not freed, after
+ * each parse and grows its backing buffer to the largest payload seen. Steady-state
+ * parsing therefore performs (almost) no heap allocation.
+ *
+ * The returned document (check HasParseError()) stays valid until the next call on the
+ * same thread, so it must not be kept beyond the decoding of the current response.
+ */
+const rapidjson::Document& parse_json_body(const std::string& body);
+
+/**
+ * @brief The CCAPI_HTTP_BODY value of a GENERIC_PUBLIC_REQUEST response element, by reference
+ * (an empty string if the element has none).
+ */
+const std::string& http_body(const ccapi::Element& element);
+
+/**
+ * @brief parse_json_body on the CCAPI_HTTP_BODY value of a GENERIC_PUBLIC_REQUEST response element.
+ * The body is read by reference (no intermediate std::string copy); a missing body yields a parse error.
+ */
+const rapidjson::Document& parse_http_body(const ccapi::Element& element);
+
+} // namespace nccapi
+
+#endif // NCCAPI_JSON_BODY_HPP
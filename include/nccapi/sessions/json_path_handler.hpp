@@ -0,0 +1,135 @@
+#ifndef NCCAPI_JSON_PATH_HANDLER_HPP
+#define NCCAPI_JSON_PATH_HANDLER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rapidjson/reader.h"
+
+namespace nccapi {
+namespace detail {
+
+/**
+ * @brief SAX plumbing shared by the layout-driven decoders (decode_klines, decode_tickers).
+ * It tracks the open objects and arrays with the key followed into each object, and
+ * finds the first container at `Layout.path` ("*" matches any key). Only that container
+ * is handed to `Derived`, one element at a time.
+ *
+ * Layout provides `path` and `depth`. Derived provides:
+ *   static constexpr bool kContainerIsArray;                     // Array or object container
+ *   void onContainerOpen();
+ *   void onContainerClose();
+ *   void onElementOpen(Frame& frame);                            // Object or array directly in the container
+ *   void onElementClose();
+ *   void onElementValue(const Frame& frame, std::string_view text); // Non-null scalar directly in an element
+ *   void onKey(Frame& frame, std::string_view key);              // Any key inside the container
+ * Numbers arrive as raw text (parse with kParseNumbersAsStringsFlag), quoted numbers as strings.
+ */
+template <typename Derived, typename LayoutType, const LayoutType& Layout>
+class JsonPathHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived> {
+public:
+    struct Frame {
+        bool isArray;
+        size_t index = 0;  // Position of the next element in an array
+        std::string key;   // Last key seen in an object on the path to the container
+        int field = -1;    // Decoder-specific: the field of the last key, or of this column
+    };
+
+    JsonPathHandler() { frames.reserve(Layout.depth + 3); }
+
+    bool found() const { return matched; }
+
+    bool Null() { return value(nullptr, 0); }
+    bool Bool(bool) { return value(nullptr, 0); }
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool) { return value(str, length); }
+    bool String(const char* str, rapidjson::SizeType length, bool) { return value(str, length); }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        Frame& frame = frames.back();
+        if (containerDepth != 0) {
+            derived().onKey(frame, std::string_view(str, length));
+        } else if (frames.size() <= Layout.depth) {
+            frame.key.assign(str, length);
+        }
+        return true;
+    }
+
+    bool StartObject() { return open(false); }
+    bool StartArray() { return open(true); }
+    bool EndObject(rapidjson::SizeType) { return close(); }
+    bool EndArray(rapidjson::SizeType) { return close(); }
+
+protected:
+    bool inContainer() const { return containerDepth != 0; }
+
+    std::vector<Frame> frames;
+    size_t containerDepth = 0; // frames.size() once the container is open, 0 otherwise
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    bool matchesPath() const {
+        if (frames.size() != Layout.depth) return false;
+        for (size_t i = 0; i < Layout.depth; ++i) {
+            if (frames[i].isArray) return false;
+            if (Layout.path[i] != "*" && Layout.path[i] != frames[i].key) return false;
+        }
+        return true;
+    }
+
+    bool open(bool isArray) {
+        if (!done && containerDepth == 0 && isArray == Derived::kContainerIsArray && matchesPath()) {
+            frames.push_back(Frame{isArray});
+            containerDepth = frames.size();
+            matched = true;
+            derived().onContainerOpen();
+            return true;
+        }
+
+        Frame frame{isArray};
+        if (containerDepth != 0 && frames.size() == containerDepth) derived().onElementOpen(frame);
+        frames.push_back(std::move(frame));
+        return true;
+    }
+
+    bool close() {
+        size_t depth = frames.size();
+        frames.pop_back();
+        if (containerDepth != 0) {
+            if (depth == containerDepth) {
+                containerDepth = 0;
+                done = true;
+                derived().onContainerClose();
+            } else if (depth == containerDepth + 1) {
+                derived().onElementClose();
+            }
+        }
+        advance();
+        return true;
+    }
+
+    bool value(const char* str, size_t length) {
+        if (containerDepth != 0 && str != nullptr && frames.size() == containerDepth + 1) {
+            // Values point into the reader's buffer and are not NUL-terminated.
+            derived().onElementValue(frames.back(), std::string_view(str, length));
+        }
+        advance();
+        return true;
+    }
+
+    // Move the enclosing array to its next element.
+    void advance() {
+        if (!frames.empty() && frames.back().isArray) ++frames.back().index;
+    }
+
+    bool matched = false;
+    bool done = false;
+};
+
+} // namespace detail
+} // namespace nccapi
+
+#endif // NCCAPI_JSON_PATH_HANDLER_HPP
@@ -0,0 +1,271 @@
+#ifndef NCCAPI_KLINE_DECODER_HPP
+#define NCCAPI_KLINE_DECODER_HPP
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nccapi/candle.hpp"
+#include "nccapi/decimal.hpp"
+#include "nccapi/fixed_candle.hpp"
+#include "nccapi/sessions/json_path_handler.hpp"
+
+#include "rapidjson/reader.h"
+
+namespace nccapi {
+
+/**
+ * @brief Where the OHLCV fields of a kline payload live: a literal type, declared
+ * `constexpr` in sessions/kline_layouts.hpp and passed to decode_klines as a
+ * template argument, so that the decoder is compiled once per layout with every
+ * column index, member name and timestamp scale folded in as a constant.
+ * Fields are addressed in the order timestamp, open, high, low, close, volume.
+ */
+struct KlineLayout {
+    enum class Shape {
+        Rows,     // Array of arrays, fields by column index: [[t, o, h, l, c, v], ...]
+        Objects,  // Array of objects, fields by member name: [{"t": .., "o": ..}, ...]
+        Columns   // Object of parallel arrays, fields by member name: {"ticks": [..], "open": [..], ...}
+    };
+
+    enum Field { kTimestamp = 0, kOpen, kHigh, kLow, kClose, kVolume, kFieldCount };
+
+    static constexpr size_t kMaxDepth = 4;     // Object keys from the root to the container
+    static constexpr size_t kMaxColumns = 16;  // Rows: highest usable column index + 1
+
+    Shape shape = Shape::Rows;
+    std::array<std::string_view, kMaxDepth> path{}; // "*" matches any key
+    size_t depth = 0;
+    std::array<int, kFieldCount> indexes{{0, 1, 2, 3, 4, 5}}; // Rows: column of each field (-1 = absent)
+    std::array<std::string_view, kFieldCount> keys{};          // Objects / Columns: member name of each field (empty = absent)
+    int64_t timestamp_scale = 1;                               // Multiplier to milliseconds (1000 for second timestamps)
+
+    static constexpr KlineLayout rows(std::initializer_list<std::string_view> path, std::array<int, kFieldCount> indexes,
+                                      int64_t timestamp_scale) {
+        KlineLayout layout = with_path(Shape::Rows, path, timestamp_scale);
+        for (int column : indexes) {
+            if (column >= static_cast<int>(kMaxColumns)) throw std::out_of_range("KlineLayout: column index too large");
+        }
+        layout.indexes = indexes;
+        return layout;
+    }
+
+    static constexpr KlineLayout objects(std::initializer_list<std::string_view> path,
+                                         std::array<std::string_view, kFieldCount> keys, int64_t timestamp_scale) {
+        KlineLayout layout = with_path(Shape::Objects, path, timestamp_scale);
+        layout.keys = keys;
+        return layout;
+    }
+
+    static constexpr KlineLayout columns(std::initializer_list<std::string_view> path,
+                                         std::array<std::string_view, kFieldCount> keys, int64_t timestamp_scale) {
+        KlineLayout layout = with_path(Shape::Columns, path, timestamp_scale);
+        layout.keys = keys;
+        return layout;
+    }
+
+    /**
+     * @brief Rows: the field held by each column (-1 = ignored), as a lookup table.
+     */
+    constexpr std::array<int8_t, kMaxColumns> column_fields() const {
+        std::array<int8_t, kMaxColumns> fields{};
+        for (auto& field : fields) field = -1;
+        for (int f = 0; f < kFieldCount; ++f) {
+            if (indexes[f] >= 0) fields[static_cast<size_t>(indexes[f])] = static_cast<int8_t>(f);
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Objects / Columns: the field named `key`, or -1.
+     */
+    constexpr int field_for(std::string_view key) const {
+        for (int f = 0; f < kFieldCount; ++f) {
+            if (!keys[f].empty() && keys[f] == key) return f;
+        }
+        return -1;
+    }
+
+private:
+    static constexpr KlineLayout with_path(Shape shape, std::initializer_list<std::string_view> path, int64_t timestamp_scale) {
+        if (path.size() > kMaxDepth) throw std::out_of_range("KlineLayout: path too deep");
+        KlineLayout layout;
+        layout.shape = shape;
+        for (std::string_view key : path) layout.path[layout.depth++] = key;
+        layout.timestamp_scale = timestamp_scale;
+        return layout;
+    }
+};
+
+/**
+ * @brief The rapidjson reader shared by every decode_klines instantiation on the calling
+ * thread; it keeps its internal stack between payloads.
+ */
+rapidjson::Reader& kline_reader();
+
+namespace detail {
+
+// SAX handler specialized on one layout: shape tests are `if constexpr`, row columns map
+// to fields through a constant table, member names are compared against constant keys.
+// Path matching and frame tracking live in JsonPathHandler.
+// Row is Candle (doubles) or FixedCandle (mantissas at `scale`).
+template <const KlineLayout& Layout, typename Row>
+class KlineHandler : public JsonPathHandler<KlineHandler<Layout, Row>, KlineLayout, Layout> {
+    using Base = JsonPathHandler<KlineHandler<Layout, Row>, KlineLayout, Layout>;
+    using Frame = typename Base::Frame;
+    using Shape = KlineLayout::Shape;
+    static constexpr Shape kShape = Layout.shape;
+    static constexpr std::array<int8_t, KlineLayout::kMaxColumns> kColumnFields = Layout.column_fields();
+    friend Base;
+
+public:
+    // The container: arrays for Rows/Objects, an object for Columns.
+    static constexpr bool kContainerIsArray = kShape != Shape::Columns;
+
+    KlineHandler(std::vector<Row>& out, const FixedScale& scale) : out(out), scale(scale) {}
+
+private:
+    void onKey(Frame& frame, std::string_view key) {
+        // Inside the container only field names matter: resolve them once, here.
+        if constexpr (kShape != Shape::Rows) frame.field = Layout.field_for(key);
+    }
+
+    void onContainerOpen() { columnBase = out.size(); }
+
+    void onElementOpen(Frame& frame) {
+        if constexpr (kShape == Shape::Columns) {
+            if (frame.isArray) frame.field = this->frames.back().field;
+        } else if (frame.isArray == (kShape == Shape::Rows)) {
+            rowOpen = true;
+            row = Row();
+            hasTimestamp = false;
+            rowValid = true;
+        }
+    }
+
+    void onElementClose() {
+        if (!rowOpen) return;
+        rowOpen = false;
+        if (hasTimestamp && rowValid) out.push_back(row);
+    }
+
+    void onContainerClose() {
+        // Columns of unequal length leave rows without a timestamp: drop them, and the
+        // rows holding a value that could not be converted.
+        if constexpr (kShape == Shape::Columns) {
+            size_t kept = columnBase;
+            for (size_t i = columnBase; i < out.size(); ++i) {
+                if (out[i].timestamp != 0 && !rejected(i)) out[kept++] = out[i];
+            }
+            out.resize(kept);
+        }
+    }
+
+    void onElementValue(const Frame& frame, std::string_view text) {
+        if constexpr (kShape == Shape::Rows) {
+            if (rowOpen && frame.index < KlineLayout::kMaxColumns && kColumnFields[frame.index] >= 0) {
+                if (!assign(row, kColumnFields[frame.index], text)) rowValid = false;
+            }
+        } else if constexpr (kShape == Shape::Objects) {
+            if (rowOpen && frame.field >= 0 && !assign(row, frame.field, text)) rowValid = false;
+        } else {
+            if (frame.field >= 0) {
+                size_t at = columnBase + frame.index;
+                if (out.size() <= at) out.resize(at + 1);
+                if (!assign(out[at], frame.field, text)) rejectedRows.push_back(at);
+            }
+        }
+    }
+
+    // False if the text is not a number or does not fit the row's representation.
+    bool assign(Row& candle, int field, std::string_view text) {
+        switch (field) {
+            case KlineLayout::kTimestamp: {
+                int64_t ts = 0;
+                double seconds = 0.0;
+                if (parse_integer(text, ts)) {
+                    if constexpr (Layout.timestamp_scale != 1) ts *= Layout.timestamp_scale;
+                } else if (parse_decimal(text, seconds)) {
+                    ts = static_cast<int64_t>(seconds * Layout.timestamp_scale);
+                }
+                candle.timestamp = static_cast<uint64_t>(ts);
+                if constexpr (kShape != Shape::Columns) hasTimestamp = ts > 0;
+                return true;
+            }
+            case KlineLayout::kOpen: return store(candle.open, text, scale.price);
+            case KlineLayout::kHigh: return store(candle.high, text, scale.price);
+            case KlineLayout::kLow: return store(candle.low, text, scale.price);
+            case KlineLayout::kClose: return store(candle.close, text, scale.price);
+            case KlineLayout::kVolume: return store(candle.volume, text, scale.volume);
+        }
+        return true;
+    }
+
+    static bool store(double& slot, std::string_view text, int) { return parse_decimal(text, slot); }
+
+    static bool store(int64_t& slot, std::string_view text, int digits) {
+        Decimal value;
+        if (!Decimal::parse(text, digits, value)) return false;
+        slot = value.mantissa;
+        return true;
+    }
+
+    bool rejected(size_t index) const {
+        for (size_t at : rejectedRows) {
+            if (at == index) return true;
+        }
+        return false;
+    }
+
+    std::vector<Row>& out;
+    FixedScale scale;
+    size_t columnBase = 0;       // Columns shape: index in `out` of the first row of this payload
+    bool rowOpen = false;
+    bool hasTimestamp = false;
+    bool rowValid = true;        // Every value of the open row converted
+    std::vector<size_t> rejectedRows; // Columns shape: rows with a value that did not convert
+    Row row;
+};
+
+} // namespace detail
+
+/**
+ * @brief Stream a kline payload through a SAX reader, appending one row per kline to `out`.
+ * No DOM is built: numbers are read as raw text (quoted or not) and converted in place,
+ * so the payload is never held in memory twice. Only the first container matching
+ * `Layout.path` is decoded; rows without a timestamp are skipped, and so are rows with a
+ * field that is not a number or overflows the mantissa at `scale` (never stored as 0).
+ * For FixedCandle rows the decimal text of each field is converted straight to a mantissa
+ * at `scale.price` / `scale.volume`, never via double; Candle rows ignore `scale`.
+ * @return false if the body is not valid JSON or contains no matching container
+ * (rows of a malformed payload are removed again).
+ */
+template <const KlineLayout& Layout, typename Row>
+bool decode_klines(const std::string& body, const FixedScale& scale, std::vector<Row>& out) {
+    rapidjson::Reader& reader = kline_reader();
+    size_t initialSize = out.size();
+    detail::KlineHandler<Layout, Row> handler(out, scale);
+    rapidjson::StringStream stream(body.c_str());
+    reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(stream, handler);
+    if (reader.HasParseError()) {
+        out.resize(initialSize);
+        return false;
+    }
+    return handler.found();
+}
+
+/**
+ * @brief decode_klines into double candles.
+ */
+template <const KlineLayout& Layout>
+bool decode_klines(const std::string& body, std::vector<Candle>& out) {
+    return decode_klines<Layout>(body, FixedScale(), out);
+}
+
+} // namespace nccapi
+
+#endif // NCCAPI_KLINE_DECODER_HPP
@@ -0,0 +1,74 @@
+#ifndef NCCAPI_KLINE_LAYOUTS_HPP
+#define NCCAPI_KLINE_LAYOUTS_HPP
+
+#include "nccapi/sessions/kline_decoder.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief The KlineLayout of every exchange decoded by decode_klines, in one place so that
+ * tests/test_kline_decoder.cpp checks the exact constants the exchange classes use.
+ * Columns are listed as the exchange sends them; fields are picked in the order
+ * timestamp, open, high, low, close, volume.
+ */
+namespace kline_layouts {
+
+// Bitfinex: [[ms, open, close, high, low, volume], ...]
+inline constexpr KlineLayout kBitfinex = KlineLayout::rows({}, {{0, 1, 3, 4, 2, 5}}, 1);
+
+// Bitget Futures (V2): {"data": [[ms, open, high, low, close, base volume, quote volume], ...]}
+inline constexpr KlineLayout kBitgetFutures = KlineLayout::rows({"data"}, {{0, 1, 2, 3, 4, 5}}, 1);
+
+// Bitmart: {"data": [[sec, open, high, low, close, volume, quote volume], ...]}
+inline constexpr KlineLayout kBitmart = KlineLayout::rows({"data"}, {{0, 1, 2, 3, 4, 5}}, 1000);
+
+// Bitstamp: {"data": {"ohlc": [{"timestamp": "sec", "open": "..", "high": "..", "low": "..", "close": "..", "volume": ".."}, ...]}}
+inline constexpr KlineLayout kBitstamp = KlineLayout::objects({"data", "ohlc"}, {{"timestamp", "open", "high", "low", "close", "volume"}}, 1000);
+
+// Coinbase: [[sec, low, high, open, close, volume], ...] (newest first)
+inline constexpr KlineLayout kCoinbase = KlineLayout::rows({}, {{0, 3, 2, 1, 4, 5}}, 1000);
+
+// Crypto.com: {"result": {"data": [{"t": ms, "o": "..", "h": "..", "l": "..", "c": "..", "v": ".."}, ...]}}
+inline constexpr KlineLayout kCryptocom = KlineLayout::objects({"result", "data"}, {{"t", "o", "h", "l", "c", "v"}}, 1);
+
+// Deribit: {"result": {"ticks": [ms, ...], "open": [...], "high": [...], ...}}
+inline constexpr KlineLayout kDeribit = KlineLayout::columns({"result"}, {{"ticks", "open", "high", "low", "close", "volume"}}, 1);
+
+// Gate.io Spot: [[sec, quote volume, close, high, low, open, base volume, closed], ...] (strings)
+inline constexpr KlineLayout kGateio = KlineLayout::rows({}, {{0, 5, 3, 4, 2, 1}}, 1000);
+
+// Gate.io Perpetual: [{"t": sec, "o": "..", "h": "..", "l": "..", "c": "..", "v": contracts}, ...]
+inline constexpr KlineLayout kGateioPerpetualFutures = KlineLayout::objects({}, {{"t", "o", "h", "l", "c", "v"}}, 1000);
+
+// Gemini: [[ms, open, high, low, close, volume], ...]
+inline constexpr KlineLayout kGemini = KlineLayout::rows({}, {{0, 1, 2, 3, 4, 5}}, 1);
+
+// Huobi: {"data": [{"id": sec, "open": .., "high": .., "low": .., "close": .., "vol": ..}, ...]}
+inline constexpr KlineLayout kHuobi = KlineLayout::objects({"data"}, {{"id", "open", "high", "low", "close", "vol"}}, 1000);
+
+// Huobi Coin-M and USDT-M swaps: same payload as spot ("vol" in contracts)
+inline constexpr KlineLayout kHuobiCoinSwap = kHuobi;
+inline constexpr KlineLayout kHuobiUsdtSwap = kHuobi;
+
+// Kraken: {"result": {"<pair>": [[sec, open, high, low, close, vwap, volume, count], ...], "last": ..}}
+inline constexpr KlineLayout kKraken = KlineLayout::rows({"result", "*"}, {{0, 1, 2, 3, 4, 6}}, 1000);
+
+// Kraken Futures: {"candles": [{"time": ms, "open": "..", "high": .., "low": .., "close": .., "volume": ..}, ...]}
+inline constexpr KlineLayout kKrakenFutures = KlineLayout::objects({"candles"}, {{"time", "open", "high", "low", "close", "volume"}}, 1);
+
+// MEXC: [[ms, open, high, low, close, volume, close time, quote volume], ...]
+inline constexpr KlineLayout kMexc = KlineLayout::rows({}, {{0, 1, 2, 3, 4, 5}}, 1);
+
+// MEXC Futures: {"data": {"time": [sec, ...], "open": [...], "close": [...], ...}}
+inline constexpr KlineLayout kMexcFutures = KlineLayout::columns({"data"}, {{"time", "open", "high", "low", "close", "vol"}}, 1000);
+
+// WhiteBIT: {"result": [[sec, open, close, high, low, base volume, quote volume], ...]},
+// some endpoints return the bare array
+inline constexpr KlineLayout kWhitebit = KlineLayout::rows({"result"}, {{0, 1, 3, 4, 2, 5}}, 1000);
+inline constexpr KlineLayout kWhitebitBare = KlineLayout::rows({}, {{0, 1, 3, 4, 2, 5}}, 1000);
+
+} // namespace kline_layouts
+
+} // namespace nccapi
+
+#endif // NCCAPI_KLINE_LAYOUTS_HPP
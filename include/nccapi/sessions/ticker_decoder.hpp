@@ -0,0 +1,139 @@
+#ifndef NCCAPI_TICKER_DECODER_HPP
+#define NCCAPI_TICKER_DECODER_HPP
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nccapi/decimal.hpp"
+#include "nccapi/ticker_table.hpp"
+#include "nccapi/sessions/json_path_handler.hpp"
+
+#include "rapidjson/reader.h"
+
+namespace nccapi {
+
+/**
+ * @brief Where the fields of an all-symbols ticker payload live: an array of objects
+ * found under `path`, with one member name per field. Like KlineLayout it is declared
+ * `constexpr` next to the exchange's request code and passed to decode_tickers as a
+ * template argument, so member names are compared against constants.
+ * Fields are addressed in the order instrument, last, bid, ask, volume.
+ */
+struct TickerLayout {
+    enum Field { kInstrument = 0, kLast, kBid, kAsk, kVolume, kFieldCount };
+
+    static constexpr size_t kMaxDepth = 4; // Object keys from the root to the array
+
+    std::array<std::string_view, kMaxDepth> path{}; // "*" matches any key
+    size_t depth = 0;
+    std::array<std::string_view, kFieldCount> keys{}; // Member name of each field (empty = absent)
+
+    static constexpr TickerLayout objects(std::initializer_list<std::string_view> path,
+                                          std::array<std::string_view, kFieldCount> keys) {
+        if (path.size() > kMaxDepth) throw std::out_of_range("TickerLayout: path too deep");
+        TickerLayout layout;
+        for (std::string_view key : path) layout.path[layout.depth++] = key;
+        layout.keys = keys;
+        return layout;
+    }
+
+    /**
+     * @brief The field named `key`, or -1.
+     */
+    constexpr int field_for(std::string_view key) const {
+        for (int f = 0; f < kFieldCount; ++f) {
+            if (!keys[f].empty() && keys[f] == key) return f;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief The rapidjson reader shared by every decode_tickers instantiation on the calling thread.
+ */
+rapidjson::Reader& ticker_reader();
+
+namespace detail {
+
+// SAX handler for one TickerLayout: one Ticker per object of the container array.
+// Path matching and frame tracking live in JsonPathHandler.
+template <const TickerLayout& Layout>
+class TickerHandler : public JsonPathHandler<TickerHandler<Layout>, TickerLayout, Layout> {
+    using Base = JsonPathHandler<TickerHandler<Layout>, TickerLayout, Layout>;
+    using Frame = typename Base::Frame;
+    friend Base;
+
+public:
+    static constexpr bool kContainerIsArray = true;
+
+    TickerHandler(TickerTable& out, std::string_view type) : out(out), type(type) {}
+
+private:
+    void onKey(Frame& frame, std::string_view key) { frame.field = Layout.field_for(key); }
+
+    void onContainerOpen() {}
+    void onContainerClose() {}
+
+    void onElementOpen(Frame& frame) {
+        if (frame.isArray) return;
+        rowOpen = true;
+        row = Ticker();
+        id.clear();
+    }
+
+    void onElementClose() {
+        if (!rowOpen) return;
+        rowOpen = false;
+        if (!id.empty()) {
+            row.instrument = id;
+            row.type = type;
+            out.push_back(row);
+        }
+    }
+
+    void onElementValue(const Frame& frame, std::string_view text) {
+        if (!rowOpen) return;
+        switch (frame.field) {
+            case TickerLayout::kInstrument: id.assign(text.data(), text.size()); break;
+            case TickerLayout::kLast: parse_decimal(text, row.last); break;
+            case TickerLayout::kBid: parse_decimal(text, row.bid); break;
+            case TickerLayout::kAsk: parse_decimal(text, row.ask); break;
+            case TickerLayout::kVolume: parse_decimal(text, row.volume); break;
+            default: break;
+        }
+    }
+
+    TickerTable& out;
+    std::string_view type;
+    bool rowOpen = false;
+    Ticker row;
+    std::string id; // Reused between rows
+};
+
+} // namespace detail
+
+/**
+ * @brief Stream an all-symbols ticker payload through a SAX reader, appending one row per
+ * object of the array at `Layout.path` to `out`, tagged with `type`. No DOM is built and
+ * numbers (quoted or not) are converted from the raw text. Objects without an instrument
+ * id are skipped.
+ * @return false if the body is not valid JSON or contains no matching array (rows of a
+ * malformed payload may remain: check the return value before using `out`).
+ */
+template <const TickerLayout& Layout>
+bool decode_tickers(const std::string& body, std::string_view type, TickerTable& out) {
+    rapidjson::Reader& reader = ticker_reader();
+    detail::TickerHandler<Layout> handler(out, type);
+    rapidjson::StringStream stream(body.c_str());
+    reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(stream, handler);
+    return !reader.HasParseError() && handler.found();
+}
+
+} // namespace nccapi
+
+#endif // NCCAPI_TICKER_DECODER_HPP
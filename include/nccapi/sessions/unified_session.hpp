@@ -1,6 +1,16 @@
 #ifndef NCCAPI_UNIFIED_SESSION_HPP
 #define NCCAPI_UNIFIED_SESSION_HPP
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nccapi/instrument_info.hpp"
+#include "nccapi/rate_limit.hpp"
+
 #include "ccapi_cpp/ccapi_session_configs.h"
 #include "ccapi_cpp/ccapi_session_options.h"
 #include "ccapi_cpp/ccapi_subscription.h"
@@ -21,17 +31,136 @@ namespace ccapi {
 namespace nccapi {
 
 class UnifiedSession {
+    class Router;
+    class Scheduler;
+
 public:
+    /**
+     * @brief Handle on an in-flight request.
+     * Every event tagged with the request's correlation ID is routed to this handle
+     * and nowhere else. The routing slot is released when the handle is destroyed.
+     */
+    class PendingRequest {
+    public:
+        PendingRequest(UnifiedSession* session, std::string correlationId);
+        PendingRequest(PendingRequest&& other) noexcept;
+        PendingRequest& operator=(PendingRequest&& other) noexcept;
+        PendingRequest(const PendingRequest&) = delete;
+        PendingRequest& operator=(const PendingRequest&) = delete;
+        ~PendingRequest();
+
+        /**
+         * @brief Blocks until events for this request arrive or the deadline passes.
+         * @return The events received since the last call (empty on timeout).
+         */
+        std::vector<ccapi::Event> wait(std::chrono::steady_clock::time_point deadline);
+
+        const std::string& getCorrelationId() const { return correlationId; }
+
+    private:
+        UnifiedSession* session;
+        std::string correlationId;
+    };
+
+    /**
+     * @brief Receives the messages of a market data subscription (data and status),
+     * on the session's event thread.
+     */
+    using StreamListener = std::function<void(const ccapi::Message&)>;
+
+    /**
+     * @brief Handle on one listener of a market data subscription.
+     * The listener is detached when the handle is closed or destroyed; a message already
+     * being delivered may still reach it once. Safe to outlive the session.
+     */
+    class Stream {
+    public:
+        Stream() = default;
+        Stream(Stream&& other) noexcept;
+        Stream& operator=(Stream&& other) noexcept;
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+        ~Stream();
+
+        void close();
+        bool isOpen() const { return listenerId != 0; }
+
+    private:
+        friend class UnifiedSession;
+        Stream(std::weak_ptr<Router> router, std::string correlationId, uint64_t listenerId);
+
+        std::weak_ptr<Router> router;
+        std::string correlationId;
+        uint64_t listenerId = 0;
+    };
+
+    /**
+     * @brief Outcome of fanOut(): the response messages of each sub-request, in request order.
+     */
+    struct FanOutResult {
+        struct Failure {
+            size_t index;        // Position of the sub-request in the input vector
+            bool timedOut;       // true: no response before the deadline; false: error response
+            std::string reason;
+        };
+        std::vector<std::vector<ccapi::Message>> messages;
+        std::vector<Failure> failures;
+    };
+
+    /**
+     * @param eventHandler Optional handler receiving the events that no pending request claims.
+     * Every exchange starts with its entry from default_rate_limits().
+     */
     UnifiedSession(const ccapi::SessionOptions& options, const ccapi::SessionConfigs& configs, ccapi::EventHandler* eventHandler = nullptr);
     ~UnifiedSession();
 
-    void sendRequest(ccapi::Request& request);
+    /**
+     * @brief Tags the request with a unique correlation ID and sends it.
+     * Thread-safe: concurrent callers each receive only their own responses.
+     * If the exchange's token bucket is empty the request is queued and sent by the
+     * scheduler once tokens are available; a request whose PendingRequest is destroyed
+     * while still queued is never sent.
+     */
+    PendingRequest sendRequest(ccapi::Request& request);
+
+    /**
+     * @brief Sends all requests at once and waits for every response (or the timeout).
+     * Used by loaders that must query several parameter values (instType, settle, ...):
+     * the whole batch costs one round trip instead of one per sub-request.
+     */
+    FanOutResult fanOut(std::vector<ccapi::Request>& requests, std::chrono::steady_clock::duration timeout);
+    /**
+     * @brief Subscribe to a ccapi market data `field` (CCAPI_CANDLESTICK, CCAPI_TRADE, ...) of
+     * one instrument and deliver its messages to `listener`.
+     * Identical subscriptions (same exchange, instrument, field and options) share one
+     * ccapi subscription and fan out to all their listeners. ccapi cannot unsubscribe, so
+     * the exchange keeps streaming after the last listener is closed; a later identical
+     * subscription reuses that stream. A stream the exchange rejects (SUBSCRIPTION_FAILURE,
+     * delivered to its listeners) is not reused: the next identical subscription retries.
+     */
+    Stream subscribe(const std::string& exchange, const std::string& instrument, const std::string& field,
+                     const std::string& options, StreamListener listener);
+
     void stop();
 
-    ccapi::Queue<ccapi::Event>& getEventQueue();
+    /**
+     * @brief Replace the token bucket of `exchange` (a limit with requests_per_second <= 0 disables it).
+     */
+    void setRateLimit(const std::string& exchange, const RateLimit& limit);
+
+    /**
+     * @brief How instrument loaders keep Instrument::info (default InfoMode::Eager).
+     */
+    void setInfoMode(InfoMode mode) { instrumentInfoMode.store(mode); }
+    InfoMode infoMode() const { return instrumentInfoMode.load(); }
 
 private:
+    void release(const std::string& correlationId);
+
     ccapi::Session* session;
+    std::shared_ptr<Router> router;
+    std::unique_ptr<Scheduler> scheduler;
+    std::atomic<InfoMode> instrumentInfoMode{InfoMode::Eager};
 };
 
 }
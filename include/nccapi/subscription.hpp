@@ -0,0 +1,128 @@
+#ifndef NCCAPI_SUBSCRIPTION_HPP
+#define NCCAPI_SUBSCRIPTION_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace nccapi {
+
+/**
+ * @brief Failure state of a subscription, shared by its Subscription handle and its
+ * stream listener. Only the first failure is kept.
+ */
+class SubscriptionStatus {
+public:
+    using ErrorHandler = std::function<void(const std::string&)>;
+
+    /**
+     * @brief Record a failure and pass it to the error handler, if one is set.
+     * @return true if a handler received the error.
+     */
+    bool fail(const std::string& error) {
+        ErrorHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (failed_) return static_cast<bool>(handler_);
+            failed_ = true;
+            error_ = error;
+            handler = handler_;
+        }
+        if (handler) handler(error);
+        return static_cast<bool>(handler);
+    }
+
+    bool failed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failed_;
+    }
+
+    std::string error() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+    /**
+     * @brief Set the error handler; it is called at once if the failure already happened.
+     */
+    void on_error(ErrorHandler handler) {
+        std::string error;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            handler_ = handler;
+            if (!failed_) return;
+            error = error_;
+        }
+        if (handler) handler(error);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    bool failed_ = false;
+    std::string error_;
+    ErrorHandler handler_;
+};
+
+/**
+ * @brief Handle on a live subscription returned by the Client::subscribe_* calls.
+ * Updates are delivered until cancel() is called or the handle is destroyed;
+ * an update already being delivered may still arrive once after that.
+ * A subscription the exchange rejects (ccapi SUBSCRIPTION_FAILURE) reports it through
+ * failed() / error() and the on_error() handler, called on the session's event thread.
+ */
+class Subscription {
+public:
+    Subscription() = default;
+    explicit Subscription(std::function<void()> cancel, std::shared_ptr<SubscriptionStatus> status = nullptr)
+        : cancel_(std::move(cancel)), status_(std::move(status)) {}
+
+    Subscription(Subscription&& other) noexcept : cancel_(std::move(other.cancel_)), status_(std::move(other.status_)) {
+        other.cancel_ = nullptr;
+    }
+    Subscription& operator=(Subscription&& other) noexcept {
+        if (this != &other) {
+            cancel();
+            cancel_ = std::move(other.cancel_);
+            other.cancel_ = nullptr;
+            status_ = std::move(other.status_);
+        }
+        return *this;
+    }
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+    ~Subscription() { cancel(); }
+
+    void cancel() {
+        if (!cancel_) return;
+        auto cancel = std::move(cancel_);
+        cancel_ = nullptr;
+        cancel();
+    }
+
+    bool active() const { return static_cast<bool>(cancel_); }
+
+    bool failed() const { return status_ && status_->failed(); }
+
+    /**
+     * @brief The exchange's reason for the failure, empty while the subscription has not failed.
+     */
+    std::string error() const { return status_ ? status_->error() : std::string(); }
+
+    /**
+     * @brief Called once with the reason if the subscription fails, at once if it already
+     * has. Without a handler the failure is printed as a [WARN] on std::cerr.
+     */
+    void on_error(SubscriptionStatus::ErrorHandler handler) {
+        if (status_) status_->on_error(std::move(handler));
+    }
+
+private:
+    std::function<void()> cancel_;
+    std::shared_ptr<SubscriptionStatus> status_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_SUBSCRIPTION_HPP
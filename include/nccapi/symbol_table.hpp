@@ -0,0 +1,74 @@
+#ifndef NCCAPI_SYMBOL_TABLE_HPP
+#define NCCAPI_SYMBOL_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nccapi {
+
+/**
+ * @brief Index of an interned string in a SymbolTable. 0 is always the empty string.
+ */
+using SymbolId = uint32_t;
+
+/**
+ * @brief Interning string table: every distinct string is stored once, in large
+ * character blocks, and referred to by a 32-bit SymbolId.
+ * Two ids from the same table are equal if and only if their strings are equal,
+ * so equality filters on interned fields are integer compares.
+ * Not synchronised: build it on one thread, then share it read-only.
+ */
+class SymbolTable {
+public:
+    static constexpr SymbolId kEmpty = 0;
+    static constexpr SymbolId kNotFound = static_cast<SymbolId>(-1);
+
+    SymbolTable();
+    SymbolTable(SymbolTable&&) noexcept = default;
+    SymbolTable& operator=(SymbolTable&&) noexcept = default;
+
+    /**
+     * @brief Id of `text`, adding it on first use.
+     */
+    SymbolId intern(std::string_view text);
+
+    /**
+     * @brief Id of `text`, or kNotFound if it was never interned.
+     */
+    SymbolId find(std::string_view text) const;
+
+    /**
+     * @brief The string of `id`; valid as long as the table lives.
+     */
+    std::string_view name(SymbolId id) const { return names_[id]; }
+
+    /**
+     * @brief Number of distinct strings (including the empty string).
+     */
+    size_t size() const { return names_.size(); }
+
+    /**
+     * @brief Heap bytes held by the table (blocks, name views and the hash index, approximately).
+     */
+    size_t memory_usage() const;
+
+private:
+    static constexpr size_t kBlockSize = 16 * 1024;
+
+    const char* store(std::string_view text);
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t block_used_ = kBlockSize; // Bytes used in blocks_.back(); kBlockSize forces a new block
+    size_t block_bytes_ = 0;
+    std::vector<std::string_view> names_;
+    std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_SYMBOL_TABLE_HPP
@@ -0,0 +1,156 @@
+#ifndef NCCAPI_TICKER_TABLE_HPP
+#define NCCAPI_TICKER_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "nccapi/candle_series.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief One row of a TickerTable. The string views point into the table.
+ */
+struct Ticker {
+    std::string_view instrument;
+    std::string_view type; // Same values as Instrument::type ("spot", "swap", "future")
+    double last = 0.0;
+    double bid = 0.0;
+    double ask = 0.0;
+    double volume = 0.0;   // 24h volume in base units, or contracts where the exchange only reports those
+};
+
+/**
+ * @brief Column-oriented snapshot of the tickers of a whole exchange.
+ * Prices and volumes live in their own contiguous, 64-byte aligned arrays (as in
+ * CandleSeries), instrument ids are packed back to back in one string, and the few
+ * distinct instrument types are stored once. A field the exchange did not report is 0.
+ */
+class TickerTable {
+public:
+    template <typename T>
+    using Column = CandleSeries::Column<T>;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    TickerTable() = default;
+
+    size_t size() const { return last_.size(); }
+    bool empty() const { return last_.empty(); }
+
+    void reserve(size_t n, size_t id_bytes = 0) {
+        ids_.reserve(id_bytes > 0 ? id_bytes : n * 12);
+        offsets_.reserve(n + 1);
+        type_ids_.reserve(n);
+        last_.reserve(n);
+        bid_.reserve(n);
+        ask_.reserve(n);
+        volume_.reserve(n);
+    }
+
+    void clear() {
+        ids_.clear();
+        offsets_.assign(1, 0);
+        types_.clear();
+        type_ids_.clear();
+        last_.clear();
+        bid_.clear();
+        ask_.clear();
+        volume_.clear();
+        timestamp_ = 0;
+    }
+
+    /**
+     * @brief Drop the rows from `n` on (e.g. those of a payload that failed to decode).
+     */
+    void truncate(size_t n) {
+        if (n >= size()) return;
+        ids_.resize(offsets_[n]);
+        offsets_.resize(n + 1);
+        type_ids_.resize(n);
+        last_.resize(n);
+        bid_.resize(n);
+        ask_.resize(n);
+        volume_.resize(n);
+    }
+
+    void push_back(std::string_view instrument, std::string_view type, double last, double bid, double ask, double volume) {
+        ids_.append(instrument.data(), instrument.size());
+        offsets_.push_back(static_cast<uint32_t>(ids_.size()));
+        type_ids_.push_back(type_id(type));
+        last_.push_back(last);
+        bid_.push_back(bid);
+        ask_.push_back(ask);
+        volume_.push_back(volume);
+    }
+
+    void push_back(const Ticker& ticker) {
+        push_back(ticker.instrument, ticker.type, ticker.last, ticker.bid, ticker.ask, ticker.volume);
+    }
+
+    /**
+     * @brief Materialise row `i` as a Ticker.
+     */
+    Ticker operator[](size_t i) const {
+        Ticker ticker;
+        ticker.instrument = instrument(i);
+        ticker.type = type(i);
+        ticker.last = last_[i];
+        ticker.bid = bid_[i];
+        ticker.ask = ask_[i];
+        ticker.volume = volume_[i];
+        return ticker;
+    }
+
+    std::string_view instrument(size_t i) const {
+        return std::string_view(ids_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+    std::string_view type(size_t i) const { return types_[type_ids_[i]]; }
+
+    const double* lasts() const { return last_.data(); }
+    const double* bids() const { return bid_.data(); }
+    const double* asks() const { return ask_.data(); }
+    const double* volumes() const { return volume_.data(); }
+
+    /**
+     * @brief Row of `instrument` (of `type`, if given), or npos. Linear scan: build an
+     * index on top of the table for repeated lookups.
+     */
+    size_t find(std::string_view instrument, std::string_view type = {}) const {
+        for (size_t i = 0; i < size(); ++i) {
+            if (this->instrument(i) == instrument && (type.empty() || this->type(i) == type)) return i;
+        }
+        return npos;
+    }
+
+    /**
+     * @brief Local time (ms) at which the snapshot was received.
+     */
+    uint64_t timestamp() const { return timestamp_; }
+    void set_timestamp(uint64_t timestamp) { timestamp_ = timestamp; }
+
+private:
+    uint8_t type_id(std::string_view type) {
+        for (size_t i = 0; i < types_.size(); ++i) {
+            if (types_[i] == type) return static_cast<uint8_t>(i);
+        }
+        types_.emplace_back(type);
+        return static_cast<uint8_t>(types_.size() - 1);
+    }
+
+    std::string ids_;
+    std::vector<uint32_t> offsets_ = std::vector<uint32_t>(1, 0); // Row i is ids_[offsets_[i], offsets_[i + 1])
+    std::vector<std::string> types_;
+    std::vector<uint8_t> type_ids_;
+    Column<double> last_;
+    Column<double> bid_;
+    Column<double> ask_;
+    Column<double> volume_;
+    uint64_t timestamp_ = 0;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_TICKER_TABLE_HPP
@@ -0,0 +1,221 @@
+#ifndef NCCAPI_TIMEFRAME_HPP
+#define NCCAPI_TIMEFRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "nccapi/candle.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief A candle duration: a count of seconds, minutes, hours, days, weeks or months
+ * ("15m", "4h", "1M"). A literal value type: parse and compare at compile time.
+ * Buckets are aligned to the Unix epoch, weeks start on Monday and months on the 1st (UTC),
+ * as exchanges open their candles.
+ */
+class Timeframe {
+public:
+    enum class Unit : uint8_t { Second, Minute, Hour, Day, Week, Month };
+
+    constexpr Timeframe() = default; // 1m
+    constexpr Timeframe(uint32_t count, Unit unit) : count_(count), unit_(unit) {}
+
+    /**
+     * @brief Parse "<count><unit>" with unit one of s, m, h, d, w, M.
+     * @return true on success; on failure `out` is left untouched.
+     */
+    static constexpr bool parse(std::string_view text, Timeframe& out) noexcept {
+        if (text.size() < 2) return false;
+        uint64_t count = 0;
+        for (size_t i = 0; i + 1 < text.size(); ++i) {
+            char c = text[i];
+            if (c < '0' || c > '9') return false;
+            count = count * 10 + static_cast<uint64_t>(c - '0');
+            if (count > 1000000) return false;
+        }
+        if (count == 0) return false;
+        Unit unit = Unit::Minute;
+        switch (text.back()) {
+            case 's': unit = Unit::Second; break;
+            case 'm': unit = Unit::Minute; break;
+            case 'h': unit = Unit::Hour; break;
+            case 'd': unit = Unit::Day; break;
+            case 'w': unit = Unit::Week; break;
+            case 'M': unit = Unit::Month; break;
+            default: return false;
+        }
+        out = Timeframe(static_cast<uint32_t>(count), unit);
+        return true;
+    }
+
+    /**
+     * @brief parse, throwing std::invalid_argument on malformed text.
+     */
+    static constexpr Timeframe from_string(std::string_view text) {
+        Timeframe timeframe;
+        if (!parse(text, timeframe)) throw std::invalid_argument("Invalid timeframe: " + std::string(text));
+        return timeframe;
+    }
+
+    constexpr uint32_t count() const { return count_; }
+    constexpr Unit unit() const { return unit_; }
+
+    /**
+     * @brief Nominal duration; a month counts as 30 days (bucket_start is calendar-exact).
+     */
+    constexpr int64_t seconds() const { return static_cast<int64_t>(count_) * unit_seconds(unit_); }
+    constexpr int64_t ms() const { return seconds() * 1000; }
+
+    /**
+     * @brief True if every bucket of this timeframe is a whole number of `base` buckets,
+     * i.e. `base` candles can be resampled into this timeframe.
+     */
+    constexpr bool is_multiple_of(Timeframe base) const {
+        if (unit_ == Unit::Month) {
+            if (base.unit_ == Unit::Month) return count_ % base.count_ == 0;
+            return base.unit_ != Unit::Week && kDayMs % base.ms() == 0;
+        }
+        if (base.unit_ == Unit::Month) return false;
+        return ms() % base.ms() == 0 && (anchor_ms() - base.anchor_ms()) % base.ms() == 0;
+    }
+
+    /**
+     * @brief Open time (ms) of the candle containing `timestamp_ms`.
+     */
+    int64_t bucket_start(int64_t timestamp_ms) const;
+
+    /**
+     * @brief Open time (ms) of the candle after the one containing `timestamp_ms`,
+     * i.e. the exclusive end of its bucket.
+     */
+    int64_t bucket_end(int64_t timestamp_ms) const;
+
+    std::string to_string() const {
+        constexpr char units[] = {'s', 'm', 'h', 'd', 'w', 'M'};
+        return std::to_string(count_) + units[static_cast<int>(unit_)];
+    }
+
+    // Same duration: "60m" == "1h". Months only equal months ("30d" != "1M").
+    friend constexpr bool operator==(Timeframe a, Timeframe b) {
+        return a.seconds() == b.seconds() && (a.unit_ == Unit::Month) == (b.unit_ == Unit::Month);
+    }
+    friend constexpr bool operator!=(Timeframe a, Timeframe b) { return !(a == b); }
+    // Shorter first; "1M" sorts after "4w".
+    friend constexpr bool operator<(Timeframe a, Timeframe b) {
+        return a.seconds() != b.seconds() ? a.seconds() < b.seconds() : a.unit_ < b.unit_;
+    }
+
+private:
+    static constexpr int64_t kDayMs = 86400000;
+
+    static constexpr int64_t unit_seconds(Unit unit) {
+        switch (unit) {
+            case Unit::Second: return 1;
+            case Unit::Minute: return 60;
+            case Unit::Hour: return 3600;
+            case Unit::Day: return 86400;
+            case Unit::Week: return 7 * 86400;
+            case Unit::Month: return 30 * 86400;
+        }
+        return 0;
+    }
+
+    // 1970-01-01 was a Thursday: weekly buckets start 4 days after the epoch.
+    constexpr int64_t anchor_ms() const { return unit_ == Unit::Week ? 4 * kDayMs : 0; }
+
+    uint32_t count_ = 1;
+    Unit unit_ = Unit::Minute;
+};
+
+inline namespace literals {
+
+/**
+ * @brief "4h"_tf: a malformed literal in a constant expression fails to compile.
+ */
+constexpr Timeframe operator""_tf(const char* text, size_t length) {
+    return Timeframe::from_string(std::string_view(text, length));
+}
+
+} // namespace literals
+
+/**
+ * @brief One candle interval an exchange serves natively, with the value its API expects
+ * for it (e.g. Coinbase granularity "3600", Kraken interval "60", OKX bar "1H").
+ */
+struct NativeTimeframe {
+    Timeframe timeframe;
+    std::string_view code;
+};
+
+/**
+ * @brief The native candle intervals of one exchange: a view of a static array,
+ * declared next to the exchange's request code.
+ * An empty table means "not described": the timeframe is passed through as is.
+ */
+class TimeframeTable {
+public:
+    constexpr TimeframeTable() = default;
+    template <size_t N>
+    constexpr TimeframeTable(const NativeTimeframe (&entries)[N]) : entries_(entries), size_(N) {}
+
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr size_t size() const { return size_; }
+    constexpr const NativeTimeframe* begin() const { return entries_; }
+    constexpr const NativeTimeframe* end() const { return entries_ + size_; }
+
+    /**
+     * @brief The entry for `timeframe`, or nullptr if the exchange does not serve it.
+     */
+    constexpr const NativeTimeframe* find(Timeframe timeframe) const {
+        for (const auto& entry : *this) {
+            if (entry.timeframe == timeframe) return &entry;
+        }
+        return nullptr;
+    }
+
+    constexpr bool supports(Timeframe timeframe) const { return find(timeframe) != nullptr; }
+
+    /**
+     * @brief find, throwing std::invalid_argument (listing the native intervals) if absent.
+     */
+    const NativeTimeframe& require(Timeframe timeframe, std::string_view exchange) const;
+
+    /**
+     * @brief Parse `timeframe` and require it.
+     */
+    const NativeTimeframe& require(std::string_view timeframe, std::string_view exchange) const {
+        return require(Timeframe::from_string(timeframe), exchange);
+    }
+
+    /**
+     * @brief The native interval to fetch for `target`: its own entry when served,
+     * otherwise the longest native interval it is a multiple of (candles are then
+     * resampled locally). Empty if none fits.
+     */
+    std::optional<Timeframe> source_for(Timeframe target) const;
+
+    /**
+     * @brief "1m, 5m, 1h" (for error messages).
+     */
+    std::string to_string() const;
+
+private:
+    const NativeTimeframe* entries_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Aggregate time-ordered `candles` into `target` buckets (open of the first,
+ * close of the last, high/low extremes, summed volume; timestamp = bucket_start).
+ * The source timeframe must divide `target` (see Timeframe::is_multiple_of).
+ */
+std::vector<Candle> resample_candles(const std::vector<Candle>& candles, Timeframe target);
+
+} // namespace nccapi
+
+#endif // NCCAPI_TIMEFRAME_HPP
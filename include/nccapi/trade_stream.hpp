@@ -0,0 +1,125 @@
+#ifndef NCCAPI_TRADE_STREAM_HPP
+#define NCCAPI_TRADE_STREAM_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "nccapi/candle.hpp"
+#include "nccapi/candle_stream.hpp"
+#include "nccapi/timeframe.hpp"
+
+namespace nccapi {
+
+/**
+ * @brief One public trade, normalized from the exchange's trade stream.
+ * Trivially copyable, so it can be queued (see Channel). The string views point into
+ * the subscription and stay valid until it is cancelled or destroyed.
+ */
+struct Trade {
+    static constexpr size_t kMaxIdLength = 47;
+
+    std::string_view exchange;
+    std::string_view instrument;
+    uint64_t timestamp = 0; // Exchange execution time in milliseconds
+    double price = 0.0;
+    double size = 0.0;
+    bool is_buyer_maker = false; // True if the taker sold
+    char id[kMaxIdLength + 1] = {}; // Exchange trade ID (NUL-terminated, truncated), empty if not provided
+
+    void set_id(std::string_view text) {
+        const size_t length = text.size() < kMaxIdLength ? text.size() : kMaxIdLength;
+        text.copy(id, length);
+        id[length] = '\0';
+    }
+};
+
+/**
+ * @brief Receives Trades on the session's event thread: keep it short, or hand
+ * the trade over to another thread.
+ */
+using TradeHandler = std::function<void(const Trade&)>;
+
+/**
+ * @brief Options of a TradeAggregator.
+ */
+struct TradeAggregatorOptions {
+    // How long after a bar's end trades of that bar are still accepted before it is
+    // closed, to absorb the latency between execution and delivery.
+    std::chrono::milliseconds close_delay = std::chrono::milliseconds(250);
+    // Emit flat bars (OHLC = previous close, volume 0) for buckets without any trade.
+    bool fill_gaps = false;
+};
+
+/**
+ * @brief Builds OHLCV bars of any Timeframe from a trade stream, for exchanges that
+ * do not stream the candles wanted (Bitstamp, Gemini, sub-minute bars on Kraken).
+ * Buckets are [bucket_start, bucket_end): a trade stamped exactly on a boundary opens
+ * the next bar. Every trade updates the forming bar (CandleUpdate::closed false);
+ * the bar is closed by advance() once the clock passes its end plus `close_delay`,
+ * or earlier by the first trade of a later bucket. Trades older than the forming
+ * bar arrive after their bar was closed: they are dropped and counted.
+ * add() and advance() may be called from different threads; the handler runs under
+ * the aggregator's lock, so updates never overlap (it must not call back into it).
+ */
+class TradeAggregator {
+public:
+    /**
+     * @brief Called with the time (ms) at which advance() has to run next.
+     */
+    using Scheduler = std::function<void(int64_t deadline_ms)>;
+
+    TradeAggregator(std::string exchange,
+                    std::string instrument,
+                    Timeframe timeframe,
+                    CandleHandler handler,
+                    TradeAggregatorOptions options = {});
+
+    /**
+     * @brief Install the callback asking for advance() to be called at a deadline.
+     * Without one, bars are only closed by later trades or explicit advance() calls.
+     */
+    void set_scheduler(Scheduler scheduler);
+
+    void add(const Trade& trade);
+
+    /**
+     * @brief Close the forming bar if `now_ms` is past its end plus the close delay
+     * (and, with fill_gaps, emit the flat bars that are due).
+     */
+    void advance(int64_t now_ms);
+
+    /**
+     * @brief Number of trades dropped because their bar was already closed.
+     */
+    uint64_t late_trades() const;
+
+private:
+    static constexpr int64_t kNoDeadline = std::numeric_limits<int64_t>::max();
+
+    void emit(bool closed);
+    void close_through(int64_t bucket); // Close the forming bar and fill the gaps up to `bucket`
+    void schedule();
+
+    std::string exchange_;
+    std::string instrument_;
+    Timeframe timeframe_;
+    CandleHandler handler_;
+    TradeAggregatorOptions options_;
+    Scheduler scheduler_;
+
+    mutable std::mutex mutex_;
+    Candle current_;
+    int64_t end_ = 0; // Exclusive end of current_'s bucket
+    bool started_ = false; // current_ holds a bar (open or closed)
+    bool open_ = false;
+    int64_t scheduled_ = kNoDeadline; // Deadline last passed to the scheduler
+    uint64_t late_trades_ = 0;
+};
+
+} // namespace nccapi
+
+#endif // NCCAPI_TRADE_STREAM_HPP
@@ -0,0 +1,205 @@
+#include "nccapi/candle_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace nccapi {
+
+namespace {
+    const char kMagic[4] = {'N', 'C', 'C', '1'};
+
+    // Keep file names portable: anything but [A-Za-z0-9._-] becomes '_' ("BTC/USD" -> "BTC_USD").
+    std::string sanitize(const std::string& name) {
+        std::string out = name;
+        for (auto& c : out) {
+            bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                      c == '.' || c == '_' || c == '-';
+            if (!ok) c = '_';
+        }
+        return out;
+    }
+
+    // Sort and coalesce overlapping or touching ranges.
+    std::vector<CandleCache::Range> normalize(std::vector<CandleCache::Range> ranges) {
+        std::sort(ranges.begin(), ranges.end());
+        std::vector<CandleCache::Range> merged;
+        for (const auto& range : ranges) {
+            if (!merged.empty() && range.first <= merged.back().second + 1) {
+                merged.back().second = std::max(merged.back().second, range.second);
+            } else {
+                merged.push_back(range);
+            }
+        }
+        return merged;
+    }
+
+    // On-disk sizes of one covered range and one candle row.
+    constexpr uint64_t kRangeBytes = 2 * sizeof(int64_t);
+    constexpr uint64_t kCandleBytes = sizeof(uint64_t) + 5 * sizeof(double);
+
+    // Temporary file next to `path`, unique across processes and threads writing the same cache.
+    std::string temp_path(const std::string& path) {
+        static const uint64_t process_token = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+        static std::atomic<uint64_t> counter{0};
+        return path + ".tmp." + std::to_string(process_token) + "." + std::to_string(counter.fetch_add(1));
+    }
+
+    template <typename T>
+    bool read_value(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    template <typename T>
+    void write_value(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+CandleCache::CandleCache(std::string directory) : directory_(std::move(directory)) {}
+
+std::string CandleCache::path_for(const std::string& exchange, const std::string& instrument, const std::string& timeframe) const {
+    return directory_ + "/" + sanitize(exchange) + "/" + sanitize(instrument) + "/" + sanitize(timeframe) + ".bin";
+}
+
+CandleCache::Entry CandleCache::read(const std::string& path) const {
+    Entry entry;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return entry;
+
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(magic)) != 0) {
+        return entry; // Unknown or corrupt file: treat as empty, it is rewritten on the next store
+    }
+
+    // Counts come from the file: never allocate more rows than the bytes left can hold.
+    in.seekg(0, std::ios::end);
+    const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(sizeof(kMagic), std::ios::beg);
+    auto remaining = [&in, file_size]() {
+        std::streamoff position = in.tellg();
+        return position < 0 ? 0 : file_size - static_cast<uint64_t>(position);
+    };
+
+    uint32_t range_count = 0;
+    if (!read_value(in, range_count)) return entry;
+    if (range_count > remaining() / kRangeBytes) return entry;
+    std::vector<Range> ranges(range_count);
+    for (auto& range : ranges) {
+        if (!read_value(in, range.first) || !read_value(in, range.second)) return Entry();
+    }
+
+    uint64_t candle_count = 0;
+    if (!read_value(in, candle_count)) return Entry();
+    if (candle_count > remaining() / kCandleBytes) return Entry();
+    std::vector<Candle> candles(candle_count);
+    for (auto& candle : candles) {
+        if (!read_value(in, candle.timestamp) || !read_value(in, candle.open) || !read_value(in, candle.high) ||
+            !read_value(in, candle.low) || !read_value(in, candle.close) || !read_value(in, candle.volume)) {
+            return Entry();
+        }
+    }
+
+    entry.ranges = std::move(ranges);
+    entry.candles = std::move(candles);
+    return entry;
+}
+
+void CandleCache::write(const std::string& path, const Entry& entry) const {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+    // Write to a temporary file and rename, so a crash never leaves a truncated cache file.
+    std::string tmp = temp_path(path);
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(kMagic, sizeof(kMagic));
+        write_value(out, static_cast<uint32_t>(entry.ranges.size()));
+        for (const auto& range : entry.ranges) {
+            write_value(out, range.first);
+            write_value(out, range.second);
+        }
+        write_value(out, static_cast<uint64_t>(entry.candles.size()));
+        for (const auto& candle : entry.candles) {
+            write_value(out, candle.timestamp);
+            write_value(out, candle.open);
+            write_value(out, candle.high);
+            write_value(out, candle.low);
+            write_value(out, candle.close);
+            write_value(out, candle.volume);
+        }
+        if (!out) {
+            out.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) std::remove(tmp.c_str());
+}
+
+std::vector<CandleCache::Range> CandleCache::missing(const std::string& exchange, const std::string& instrument,
+                                                     const std::string& timeframe, int64_t from_date, int64_t to_date) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry = read(path_for(exchange, instrument, timeframe));
+
+    std::vector<Range> gaps;
+    int64_t cursor = from_date;
+    for (const auto& range : entry.ranges) {
+        if (cursor > to_date) break;
+        if (range.second < cursor) continue;
+        if (range.first > cursor) {
+            gaps.emplace_back(cursor, std::min(range.first - 1, to_date));
+        }
+        cursor = std::max(cursor, range.second + 1);
+    }
+    if (cursor <= to_date) {
+        gaps.emplace_back(cursor, to_date);
+    }
+    return gaps;
+}
+
+void CandleCache::store(const std::string& exchange, const std::string& instrument, const std::string& timeframe,
+                        const std::vector<Range>& covered, const std::vector<Candle>& candles) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string path = path_for(exchange, instrument, timeframe);
+    Entry entry = read(path);
+
+    // New rows first so that, after the stable sort, unique() keeps them over cached ones.
+    std::vector<Candle> merged;
+    merged.reserve(candles.size() + entry.candles.size());
+    merged.insert(merged.end(), candles.begin(), candles.end());
+    merged.insert(merged.end(), entry.candles.begin(), entry.candles.end());
+    std::stable_sort(merged.begin(), merged.end(), [](const Candle& a, const Candle& b) {
+        return a.timestamp < b.timestamp;
+    });
+    merged.erase(std::unique(merged.begin(), merged.end(), [](const Candle& a, const Candle& b) {
+        return a.timestamp == b.timestamp;
+    }), merged.end());
+    entry.candles = std::move(merged);
+
+    for (const auto& range : covered) {
+        if (range.second >= range.first) entry.ranges.push_back(range);
+    }
+    entry.ranges = normalize(std::move(entry.ranges));
+
+    write(path, entry);
+}
+
+std::vector<Candle> CandleCache::load(const std::string& exchange, const std::string& instrument,
+                                      const std::string& timeframe, int64_t from_date, int64_t to_date) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry = read(path_for(exchange, instrument, timeframe));
+
+    auto first = std::lower_bound(entry.candles.begin(), entry.candles.end(), from_date, [](const Candle& c, int64_t ts) {
+        return static_cast<int64_t>(c.timestamp) < ts;
+    });
+    auto last = std::upper_bound(first, entry.candles.end(), to_date, [](int64_t ts, const Candle& c) {
+        return ts < static_cast<int64_t>(c.timestamp);
+    });
+    return std::vector<Candle>(first, last);
+}
+
+} // namespace nccapi
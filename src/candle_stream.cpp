@@ -0,0 +1,62 @@
+#include "nccapi/candle_stream.hpp"
+#include <utility>
+
+namespace nccapi {
+
+CandleAssembler::CandleAssembler(std::string exchange,
+                                 std::string instrument,
+                                 Timeframe timeframe,
+                                 CandleHandler handler,
+                                 std::chrono::milliseconds close_delay)
+    : exchange_(std::move(exchange)), instrument_(std::move(instrument)), timeframe_(timeframe),
+      handler_(std::move(handler)), close_delay_(close_delay) {}
+
+void CandleAssembler::set_scheduler(Scheduler scheduler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scheduler_ = std::move(scheduler);
+    if (scheduler_ && open_) scheduler_(end_ + close_delay_.count());
+}
+
+void CandleAssembler::update(const Candle& candle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Candle bar = candle;
+    const int64_t timestamp = static_cast<int64_t>(candle.timestamp);
+    bar.timestamp = static_cast<uint64_t>(timeframe_.bucket_start(timestamp));
+    const bool new_bar = !started_ || bar.timestamp > current_.timestamp;
+    if (started_) {
+        // Late snapshots of a bar already replaced or closed are dropped.
+        if (bar.timestamp < current_.timestamp || (bar.timestamp == current_.timestamp && !open_)) return;
+        if (new_bar && open_) emit(true);
+    }
+    current_ = bar;
+    started_ = true;
+    open_ = true;
+    emit(false);
+    if (new_bar) {
+        end_ = timeframe_.bucket_end(timestamp);
+        if (scheduler_) scheduler_(end_ + close_delay_.count());
+    }
+}
+
+void CandleAssembler::advance(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_ && now_ms >= end_ + close_delay_.count()) emit(true);
+}
+
+void CandleAssembler::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) emit(true);
+}
+
+void CandleAssembler::emit(bool closed) {
+    if (closed) open_ = false;
+    CandleUpdate update;
+    update.exchange = exchange_;
+    update.instrument = instrument_;
+    update.timeframe = timeframe_;
+    update.candle = current_;
+    update.closed = closed;
+    handler_(update);
+}
+
+} // namespace nccapi
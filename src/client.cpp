@@ -1,9 +1,15 @@
 #include "nccapi/client.hpp"
+#include "nccapi/executor.hpp"
+#include "nccapi/paginator.hpp"
+#include "nccapi/candle_cache.hpp"
+#include "nccapi/deadline_timer.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "ccapi_cpp/ccapi_macro.h"
 
 // Include all exchanges
 #include "nccapi/exchanges/ascendex.hpp"
@@ -39,12 +45,25 @@
 
 namespace nccapi {
 
-Client::Client() {
+Client::Client() : Client(ClientOptions()) {}
+
+Client::Client(const ClientOptions& client_options)
+    : pages_in_flight_(client_options.pages_in_flight),
+      cache_(client_options.cache_dir.empty() ? nullptr : std::make_unique<CandleCache>(client_options.cache_dir)),
+      snapshot_dir_(client_options.snapshot_dir),
+      catalog_ttl_(client_options.catalog_ttl),
+      executor_(std::make_unique<Executor>(client_options.async_workers)) {
     // Instantiate Unified Session
     ccapi::SessionOptions options;
     options.httpRequestTimeoutMilliseconds = 30000; // Increase default timeout to 30s
     ccapi::SessionConfigs configs;
     auto unifiedSession = std::make_shared<UnifiedSession>(options, configs);
+    unifiedSession->setInfoMode(client_options.info_mode);
+    for (const auto& entry : client_options.rate_limits) {
+        unifiedSession->setRateLimit(entry.first, entry.second);
+    }
+    session_ = unifiedSession;
+    timer_ = std::make_shared<DeadlineTimer>();
 
     // Register all exchanges, passing the unified session
     exchanges_["ascendex"] = std::make_shared<Ascendex>(unifiedSession);
@@ -77,6 +96,16 @@ Client::Client() {
     exchanges_["mexc-futures"] = std::make_shared<MexcFutures>(unifiedSession);
     exchanges_["okx"] = std::make_shared<Okx>(unifiedSession);
     exchanges_["whitebit"] = std::make_shared<Whitebit>(unifiedSession);
+
+    // Warm start: catalogs come from disk, stale ones are refreshed on first use.
+    if (!snapshot_dir_.empty()) {
+        for (const auto& pair : exchanges_) {
+            InstrumentSnapshot snapshot;
+            if (read_instrument_snapshot(snapshot_path(pair.first), snapshot, client_options.info_mode)) {
+                catalogs_[pair.first] = std::move(snapshot);
+            }
+        }
+    }
 }
 
 Client::~Client() = default;
@@ -99,9 +128,457 @@ std::shared_ptr<Exchange> Client::get_exchange(const std::string& exchange_name)
     throw std::runtime_error("Exchange not supported: " + exchange_name);
 }
 
+namespace {
+
+std::string subscription_error(const ccapi::Message& message) {
+    std::string reason;
+    for (const auto& element : message.getElementList()) {
+        if (element.has(CCAPI_ERROR_MESSAGE)) reason = element.getValue(CCAPI_ERROR_MESSAGE);
+    }
+    return reason.empty() ? message.toString() : reason;
+}
+
+// Record a rejected market data subscription on its handle; print it if no error handler is set.
+void report_subscription_failure(SubscriptionStatus& status, const std::string& reason, const std::string& exchange,
+                                 const char* kind, const std::string& instrument) {
+    if (!status.fail(reason)) {
+        std::cerr << "[WARN] " << exchange << ": " << kind << " subscription for " << instrument
+                  << " failed: " << reason << std::endl;
+    }
+}
+
+} // namespace
+
+// The book of one shared order book stream and the handlers watching it. The book is
+// only touched by the stream's listener, on the session's event thread; the watcher
+// list is copied on write so that handlers run outside the lock and may cancel.
+struct Client::OrderBookFeed {
+    struct Watcher {
+        OrderBookHandler handler;
+        std::shared_ptr<SubscriptionStatus> status;
+        bool fresh = true; // Its next update is its first one: delivered as a snapshot
+    };
+    using Watchers = std::vector<std::shared_ptr<Watcher>>;
+
+    OrderBookFeed(std::string exchange_name, std::string instrument_name, double tick_size, size_t depth)
+        : exchange(std::move(exchange_name)), instrument(std::move(instrument_name)), book(tick_size, depth) {}
+
+    bool failed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !error.empty();
+    }
+
+    void add(const std::shared_ptr<Watcher>& watcher) {
+        std::string reason;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto updated = std::make_shared<Watchers>(*watchers);
+            updated->push_back(watcher);
+            watchers = std::move(updated);
+            reason = error;
+        }
+        if (!reason.empty()) report_subscription_failure(*watcher->status, reason, exchange, "order book", instrument);
+    }
+
+    void remove(const Watcher* watcher) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto updated = std::make_shared<Watchers>();
+        for (const auto& entry : *watchers) {
+            if (entry.get() != watcher) updated->push_back(entry);
+        }
+        watchers = std::move(updated);
+    }
+
+    void process(const ccapi::Message& message) {
+        if (message.getType() == ccapi::Message::Type::MARKET_DATA_EVENTS_MARKET_DEPTH) {
+            // The solicited recap is the full book; later messages carry only the changed levels (size 0: removed).
+            const bool snapshot = message.getRecapType() == ccapi::Message::RecapType::SOLICITED;
+            if (snapshot) book.clear();
+            for (const auto& element : message.getElementList()) {
+                const auto& values = element.getNameValueMap();
+                double price = 0.0;
+                double size = 0.0;
+                auto bid = values.find(CCAPI_BEST_BID_N_PRICE);
+                if (bid != values.end()) {
+                    auto bid_size = values.find(CCAPI_BEST_BID_N_SIZE);
+                    if (parse_decimal(bid->second, price) && bid_size != values.end() && parse_decimal(bid_size->second, size)) {
+                        book.set(OrderBook::Side::Bid, price, size);
+                    }
+                }
+                auto ask = values.find(CCAPI_BEST_ASK_N_PRICE);
+                if (ask != values.end()) {
+                    auto ask_size = values.find(CCAPI_BEST_ASK_N_SIZE);
+                    if (parse_decimal(ask->second, price) && ask_size != values.end() && parse_decimal(ask_size->second, size)) {
+                        book.set(OrderBook::Side::Ask, price, size);
+                    }
+                }
+            }
+            book.set_timestamp(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                message.getTime().time_since_epoch()).count()));
+            for (const auto& watcher : *current()) {
+                // A subscriber that joined a running stream gets the whole book first.
+                const bool first = watcher->fresh;
+                watcher->fresh = false;
+                watcher->handler(OrderBookUpdate{exchange, instrument, book, snapshot || first});
+            }
+        } else if (message.getType() == ccapi::Message::Type::SUBSCRIPTION_FAILURE) {
+            const std::string reason = subscription_error(message);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = reason;
+            }
+            for (const auto& watcher : *current()) {
+                report_subscription_failure(*watcher->status, reason, exchange, "order book", instrument);
+            }
+        }
+    }
+
+    std::shared_ptr<const Watchers> current() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return watchers;
+    }
+
+    const std::string exchange;
+    const std::string instrument;
+    OrderBook book;
+    UnifiedSession::Stream stream;
+
+    std::mutex mutex;
+    std::shared_ptr<const Watchers> watchers = std::make_shared<const Watchers>();
+    std::string error; // Set once the exchange rejects the stream
+};
+
+Subscription Client::subscribe_candles(const std::string& exchange_name,
+                                       const std::string& instrument_name,
+                                       const std::string& timeframe,
+                                       CandleHandler handler) {
+    auto exchange = get_exchange(exchange_name);
+    const Timeframe interval = Timeframe::from_string(timeframe);
+    const TimeframeTable native = exchange->timeframes();
+    // Candle streams carry fixed-length bars: months, and intervals the exchange does
+    // not serve, are aggregated from trades instead.
+    if (!exchange->streams_candles() || interval.unit() == Timeframe::Unit::Month ||
+        (!native.empty() && !native.supports(interval))) {
+        return subscribe_trade_candles(exchange_name, instrument_name, timeframe, std::move(handler));
+    }
+
+    auto assembler = std::make_shared<CandleAssembler>(exchange_name, instrument_name, interval, std::move(handler));
+    // Bars close on the timer at their end plus the close delay instead of waiting for the
+    // next bar's first push. Only the latest close is pending; cancelling drops it.
+    struct PendingClose {
+        std::mutex mutex;
+        uint64_t task = 0;
+        bool cancelled = false;
+    };
+    auto pending = std::make_shared<PendingClose>();
+    std::weak_ptr<CandleAssembler> weak = assembler;
+    assembler->set_scheduler([timer = timer_, pending, weak](int64_t deadline_ms) {
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        if (pending->cancelled) return;
+        timer->cancel(pending->task);
+        pending->task = timer->schedule(deadline_ms, [weak] {
+            if (auto target = weak.lock()) {
+                target->advance(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            }
+        });
+    });
+    auto status = std::make_shared<SubscriptionStatus>();
+    auto stream = std::make_shared<UnifiedSession::Stream>(session_->subscribe(
+        exchange_name, instrument_name, CCAPI_CANDLESTICK,
+        std::string(CCAPI_CANDLESTICK_INTERVAL_SECONDS) + "=" + std::to_string(interval.seconds()),
+        [assembler, status, exchange_name, instrument_name](const ccapi::Message& message) {
+            if (message.getType() == ccapi::Message::Type::MARKET_DATA_EVENTS_CANDLESTICK) {
+                // ccapi stamps candlestick messages with the bar's open time.
+                const int64_t open_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    message.getTime().time_since_epoch()).count();
+                for (const auto& element : message.getElementList()) {
+                    Candle candle;
+                    candle.timestamp = static_cast<uint64_t>(open_time);
+                    // A malformed or missing field drops the row rather than zero-filling it.
+                    if (!parse_decimal(element.getValue(CCAPI_OPEN_PRICE), candle.open) ||
+                        !parse_decimal(element.getValue(CCAPI_HIGH_PRICE), candle.high) ||
+                        !parse_decimal(element.getValue(CCAPI_LOW_PRICE), candle.low) ||
+                        !parse_decimal(element.getValue(CCAPI_CLOSE_PRICE), candle.close) ||
+                        !parse_decimal(element.getValue(CCAPI_VOLUME), candle.volume)) {
+                        continue;
+                    }
+                    assembler->update(candle);
+                }
+            } else if (message.getType() == ccapi::Message::Type::SUBSCRIPTION_FAILURE) {
+                report_subscription_failure(*status, subscription_error(message), exchange_name, "candle", instrument_name);
+            }
+        }));
+    return Subscription([stream, timer = timer_, pending] {
+        stream->close();
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        pending->cancelled = true;
+        timer->cancel(pending->task);
+    }, status);
+}
+
+Subscription Client::subscribe_trades(const std::string& exchange_name,
+                                      const std::string& instrument_name,
+                                      TradeHandler handler) {
+    get_exchange(exchange_name);
+    // Trades only view the names: the router may copy or drop its listener while a
+    // trade is in flight, so the strings are shared by the listener and the handle.
+    auto exchange = std::make_shared<const std::string>(exchange_name);
+    auto instrument = std::make_shared<const std::string>(instrument_name);
+    auto status = std::make_shared<SubscriptionStatus>();
+    auto stream = std::make_shared<UnifiedSession::Stream>(session_->subscribe(
+        exchange_name, instrument_name, CCAPI_TRADE, "",
+        [handler = std::move(handler), status, exchange, instrument](const ccapi::Message& message) {
+            if (message.getType() == ccapi::Message::Type::MARKET_DATA_EVENTS_TRADE) {
+                // ccapi stamps trade messages with the execution time.
+                const int64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    message.getTime().time_since_epoch()).count();
+                for (const auto& element : message.getElementList()) {
+                    Trade trade;
+                    trade.exchange = *exchange;
+                    trade.instrument = *instrument;
+                    trade.timestamp = static_cast<uint64_t>(time);
+                    if (!parse_decimal(element.getValue(CCAPI_LAST_PRICE), trade.price) ||
+                        !parse_decimal(element.getValue(CCAPI_LAST_SIZE), trade.size)) {
+                        continue; // Malformed trade: dropped rather than zero-filled
+                    }
+                    trade.is_buyer_maker = element.getValue(CCAPI_IS_BUYER_MAKER) == "1";
+                    trade.set_id(element.getValue(CCAPI_TRADE_ID));
+                    handler(trade);
+                }
+            } else if (message.getType() == ccapi::Message::Type::SUBSCRIPTION_FAILURE) {
+                report_subscription_failure(*status, subscription_error(message), *exchange, "trade", *instrument);
+            }
+        }));
+    return Subscription([stream, exchange, instrument] { stream->close(); }, status);
+}
+
+Subscription Client::subscribe_order_book(const std::string& exchange_name,
+                                          const std::string& instrument_name,
+                                          OrderBookHandler handler,
+                                          size_t depth) {
+    get_exchange(exchange_name);
+    if (depth == 0) throw std::invalid_argument("Order book depth must be positive");
+    auto watcher = std::make_shared<OrderBookFeed::Watcher>();
+    watcher->handler = std::move(handler);
+    watcher->status = std::make_shared<SubscriptionStatus>();
+
+    // The router shares one stream between identical subscriptions and only the first one
+    // gets the exchange's snapshot, so the book is kept per stream, not per subscriber.
+    const std::string key = exchange_name + "|" + instrument_name + "|" + std::to_string(depth);
+    std::shared_ptr<OrderBookFeed> feed;
+    {
+        std::lock_guard<std::mutex> lock(order_books_mutex_);
+        auto it = order_books_.find(key);
+        if (it != order_books_.end() && !it->second->failed()) feed = it->second;
+    }
+    if (!feed) {
+        // A cold catalog is a full instrument download: never under the lock. Another caller
+        // may open the stream meanwhile, so the entry is checked again before creating it.
+        const double tick = tick_size(exchange_name, instrument_name);
+        std::lock_guard<std::mutex> lock(order_books_mutex_);
+        std::shared_ptr<OrderBookFeed>& entry = order_books_[key];
+        if (!entry || entry->failed()) {
+            entry = std::make_shared<OrderBookFeed>(exchange_name, instrument_name, tick, depth);
+            const std::string options = std::string(CCAPI_MARKET_DEPTH_MAX) + "=" + std::to_string(depth) + "&" +
+                                        CCAPI_MARKET_DEPTH_RETURN_UPDATE + "=1";
+            std::weak_ptr<OrderBookFeed> weak = entry;
+            entry->stream = session_->subscribe(exchange_name, instrument_name, CCAPI_MARKET_DEPTH, options,
+                                                [weak](const ccapi::Message& message) {
+                                                    if (auto target = weak.lock()) target->process(message);
+                                                });
+        }
+        feed = entry;
+    }
+    feed->add(watcher);
+    return Subscription([feed, watcher] { feed->remove(watcher.get()); }, watcher->status);
+}
+
+Subscription Client::subscribe_trade_candles(const std::string& exchange_name,
+                                             const std::string& instrument_name,
+                                             const std::string& timeframe,
+                                             CandleHandler handler,
+                                             TradeAggregatorOptions options) {
+    get_exchange(exchange_name);
+    const Timeframe interval = Timeframe::from_string(timeframe);
+    auto aggregator = std::make_shared<TradeAggregator>(exchange_name, instrument_name, interval, std::move(handler), options);
+    // The timer only holds the aggregator weakly: a cancelled subscription frees it.
+    std::weak_ptr<TradeAggregator> weak = aggregator;
+    aggregator->set_scheduler([timer = timer_, weak](int64_t deadline_ms) {
+        timer->schedule(deadline_ms, [weak] {
+            if (auto target = weak.lock()) {
+                target->advance(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            }
+        });
+    });
+    return subscribe_trades(exchange_name, instrument_name, [aggregator](const Trade& trade) { aggregator->add(trade); });
+}
+
+TickerTable Client::get_tickers(const std::string& exchange_name) {
+    std::vector<PartialFailure> failures;
+    TickerTable tickers = get_tickers(exchange_name, failures);
+    warn_partial_failures(exchange_name, failures);
+    return tickers;
+}
+
+TickerTable Client::get_tickers(const std::string& exchange_name, std::vector<PartialFailure>& failures) {
+    TickerTable tickers = get_exchange(exchange_name)->get_tickers(failures);
+    tickers.set_timestamp(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()));
+    return tickers;
+}
+
 std::vector<Instrument> Client::get_pairs(const std::string& exchange_name) {
+    std::vector<PartialFailure> failures;
+    std::vector<Instrument> pairs = get_pairs(exchange_name, failures);
+    warn_partial_failures(exchange_name, failures);
+    return pairs;
+}
+
+std::vector<Instrument> Client::get_pairs(const std::string& exchange_name, std::vector<PartialFailure>& failures) {
     auto exchange = get_exchange(exchange_name);
-    return exchange->get_instruments();
+    if (snapshot_dir_.empty()) {
+        return exchange->get_instruments(failures);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(catalog_mutex_);
+        auto it = catalogs_.find(exchange_name);
+        if (it != catalogs_.end()) {
+            int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            bool stale = now - it->second.fetched_at > std::chrono::duration_cast<std::chrono::milliseconds>(catalog_ttl_).count();
+            if (stale && refreshing_.insert(exchange_name).second) {
+                executor_->post([this, exchange_name]() {
+                    try {
+                        std::vector<PartialFailure> failures;
+                        refresh_catalog(exchange_name, failures);
+                        warn_partial_failures(exchange_name, failures);
+                    } catch (const std::exception& e) {
+                        std::cerr << "[WARN] " << exchange_name << ": background catalog refresh failed: " << e.what() << std::endl;
+                    } catch (...) {
+                        std::cerr << "[WARN] " << exchange_name << ": background catalog refresh failed" << std::endl;
+                    }
+                });
+            }
+            return it->second.instruments;
+        }
+    }
+
+    return refresh_catalog(exchange_name, failures);
+}
+
+std::shared_ptr<const InstrumentCatalog> Client::get_catalog(const std::string& exchange_name) {
+    get_exchange(exchange_name);
+    auto now = [] {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    };
+    const int64_t ttl = std::chrono::duration_cast<std::chrono::milliseconds>(catalog_ttl_).count();
+
+    {
+        std::lock_guard<std::mutex> lock(catalog_mutex_);
+        auto it = indexed_catalogs_.find(exchange_name);
+        if (it != indexed_catalogs_.end()) {
+            auto snapshot = catalogs_.find(exchange_name);
+            bool current = snapshot_dir_.empty() ? now() - it->second.fetched_at <= ttl
+                                                 : snapshot != catalogs_.end() && snapshot->second.fetched_at == it->second.fetched_at;
+            if (current) return it->second.catalog;
+        }
+    }
+
+    // Stamp the catalog with the snapshot seen *before* get_pairs: if a background refresh
+    // lands meanwhile, the stamp is older than the snapshot and the next call rebuilds.
+    int64_t stamp = now();
+    bool stamped = snapshot_dir_.empty();
+    if (!stamped) {
+        std::lock_guard<std::mutex> lock(catalog_mutex_);
+        auto snapshot = catalogs_.find(exchange_name);
+        if (snapshot != catalogs_.end()) {
+            stamp = snapshot->second.fetched_at;
+            stamped = true;
+        }
+    }
+    auto catalog = std::make_shared<const InstrumentCatalog>(get_pairs(exchange_name));
+
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    if (!stamped) {
+        // First download: get_pairs has just written the snapshot it returned.
+        auto snapshot = catalogs_.find(exchange_name);
+        if (snapshot != catalogs_.end()) stamp = snapshot->second.fetched_at;
+    }
+    indexed_catalogs_[exchange_name] = IndexedCatalog{stamp, catalog};
+    return catalog;
+}
+
+CompactCatalog Client::get_compact_pairs(const std::string& exchange_name) {
+    return CompactCatalog::from_instruments(get_pairs(exchange_name));
+}
+
+std::string Client::snapshot_path(const std::string& exchange_name) const {
+    return snapshot_dir_ + "/" + exchange_name + ".bin";
+}
+
+std::vector<Instrument> Client::refresh_catalog(const std::string& exchange_name, std::vector<PartialFailure>& failures) {
+    InstrumentSnapshot snapshot;
+    const size_t failures_before = failures.size();
+    try {
+        snapshot.instruments = get_exchange(exchange_name)->get_instruments(failures);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(catalog_mutex_);
+        refreshing_.erase(exchange_name);
+        throw;
+    }
+    snapshot.fetched_at = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    refreshing_.erase(exchange_name);
+    // An empty catalog almost always means a failed download, and an incomplete one misses
+    // whole instrument types: keep serving the previous snapshot (the next call retries).
+    if (!snapshot.instruments.empty() && failures.size() == failures_before) {
+        write_instrument_snapshot(snapshot_path(exchange_name), snapshot);
+        catalogs_[exchange_name] = snapshot;
+    }
+    return snapshot.instruments;
+}
+
+std::map<std::string, PairsResult> Client::get_all_pairs(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::map<std::string, std::future<PairsResult>> pending;
+    for (const auto& pair : exchanges_) {
+        const std::string exchange_name = pair.first;
+        auto task = std::make_shared<std::packaged_task<PairsResult()>>([this, exchange_name]() {
+            PairsResult result;
+            result.instruments = get_pairs(exchange_name, result.partial_failures);
+            result.status = FetchStatus::Ok;
+            return result;
+        });
+        pending[exchange_name] = task->get_future();
+        executor_->post([task]() { (*task)(); });
+    }
+
+    std::map<std::string, PairsResult> results;
+    for (auto& pair : pending) {
+        PairsResult& result = results[pair.first];
+        if (pair.second.wait_until(deadline) != std::future_status::ready) {
+            result.status = FetchStatus::Timeout;
+            result.error = "No response before deadline";
+            continue;
+        }
+        try {
+            result = pair.second.get();
+        } catch (const std::exception& e) {
+            result.status = FetchStatus::Error;
+            result.error = e.what();
+        } catch (...) {
+            result.status = FetchStatus::Error;
+            result.error = "Unknown error";
+        }
+    }
+    return results;
 }
 
 std::vector<Candle> Client::get_historical_candles(const std::string& exchange_name,
@@ -110,19 +587,234 @@ std::vector<Candle> Client::get_historical_candles(const std::string& exchange_n
                                                    int64_t from_date,
                                                    int64_t to_date) {
     auto exchange = get_exchange(exchange_name);
+    const TimeframePlan plan = plan_timeframe(*exchange, timeframe);
 
-    // Set default logic if needed, although generic default args handle it.
-    // However, if the user passes 0, we can interpret it as defaults here if specific logic requires it.
-    // For now, pass directly.
     int64_t actual_to_date = to_date;
     if (actual_to_date <= 0) {
         actual_to_date = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
     }
 
+    // Resampled buckets must start complete: fetch from the start of the first one.
+    int64_t fetch_from = from_date;
+    if (plan.resample_to && from_date > 0) fetch_from = plan.resample_to->bucket_start(from_date);
+
     // For from_date, if 0, we leave it to the exchange to decide the default lookback.
+    // Otherwise the range is split into pages the exchange can serve in one request.
+    std::vector<Candle> candles;
+    if (cache_ && from_date > 0) {
+        candles = fetch_cached_candles(*exchange, instrument_name, plan.fetch, fetch_from, actual_to_date);
+    } else {
+        candles = fetch_candles_paginated(*exchange, instrument_name, plan.fetch, fetch_from, actual_to_date, *executor_, pages_in_flight_);
+    }
+    if (plan.resample_to) return resample_candles(candles, *plan.resample_to);
+    return candles;
+}
+
+CandleSeries Client::get_historical_candle_series(const std::string& exchange_name,
+                                                  const std::string& instrument_name,
+                                                  const std::string& timeframe,
+                                                  int64_t from_date,
+                                                  int64_t to_date) {
+    auto exchange = get_exchange(exchange_name);
+    const TimeframePlan plan = plan_timeframe(*exchange, timeframe);
+    if (plan.resample_to) {
+        return CandleSeries::from_candles(get_historical_candles(exchange_name, instrument_name, timeframe, from_date, to_date));
+    }
+
+    int64_t actual_to_date = to_date;
+    if (actual_to_date <= 0) {
+        actual_to_date = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    if (cache_ && from_date > 0) {
+        return CandleSeries::from_candles(fetch_cached_candles(*exchange, instrument_name, plan.fetch, from_date, actual_to_date));
+    }
+
+    return fetch_candle_series_paginated(*exchange, instrument_name, plan.fetch, from_date, actual_to_date, *executor_, pages_in_flight_);
+}
+
+FixedCandleSeries Client::get_historical_fixed_series(const std::string& exchange_name,
+                                                     const std::string& instrument_name,
+                                                     const std::string& timeframe,
+                                                     int64_t from_date,
+                                                     int64_t to_date) {
+    auto exchange = get_exchange(exchange_name);
+    const TimeframePlan plan = plan_timeframe(*exchange, timeframe);
+    FixedScale scale = fixed_scale(exchange_name, instrument_name);
+    if (plan.resample_to) {
+        return FixedCandleSeries::from_candles(get_historical_candles(exchange_name, instrument_name, timeframe, from_date, to_date), scale);
+    }
+
+    int64_t actual_to_date = to_date;
+    if (actual_to_date <= 0) {
+        actual_to_date = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    if (cache_ && from_date > 0) {
+        return FixedCandleSeries::from_candles(fetch_cached_candles(*exchange, instrument_name, plan.fetch, from_date, actual_to_date), scale);
+    }
+
+    return fetch_fixed_series_paginated(*exchange, instrument_name, plan.fetch, from_date, actual_to_date, scale, *executor_, pages_in_flight_);
+}
+
+Client::TimeframePlan Client::plan_timeframe(const Exchange& exchange, const std::string& timeframe) {
+    const TimeframeTable table = exchange.timeframes();
+    if (table.empty()) return TimeframePlan{timeframe, std::nullopt};
+
+    const Timeframe target = Timeframe::from_string(timeframe);
+    std::optional<Timeframe> source = table.source_for(target);
+    if (!source) table.require(target, exchange.get_name()); // Throws, listing the native intervals
+    if (*source == target) return TimeframePlan{source->to_string(), std::nullopt};
+    return TimeframePlan{source->to_string(), target};
+}
+
+FixedScale Client::fixed_scale(const std::string& exchange_name, const std::string& instrument_name) {
+    try {
+        const Instrument* instrument = get_catalog(exchange_name)->find_by_id(instrument_name);
+        if (instrument) return FixedScale::for_instrument(*instrument);
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] " << exchange_name << ": catalog unavailable (" << e.what() << ")" << std::endl;
+    }
+    std::cerr << "[WARN] " << exchange_name << ": " << instrument_name << " not in catalog, using default fixed-point scale" << std::endl;
+    return FixedScale();
+}
+
+double Client::tick_size(const std::string& exchange_name, const std::string& instrument_name) {
+    try {
+        const Instrument* instrument = get_catalog(exchange_name)->find_by_id(instrument_name);
+        if (instrument && instrument->tick_size > 0) return instrument->tick_size;
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] " << exchange_name << ": catalog unavailable (" << e.what() << ")" << std::endl;
+    }
+    std::cerr << "[WARN] " << exchange_name << ": no tick size for " << instrument_name << ", using a 1e-8 price grid" << std::endl;
+    return 0.0;
+}
+
+namespace {
+
+// Ranges of [gap_from, gap_to] the fetched candles (ascending) prove complete. A page that
+// failed or came back empty leaves a hole longer than one page span, so the coverage is
+// split there; shorter holes are quiet markets. The range before the first candle only
+// counts when it is shorter than a page (the first page did answer), and coverage ends
+// with the last candle. page_span == 0 means the exchange answered in one request.
+std::vector<CandleCache::Range> covered_ranges(const std::vector<Candle>& candles,
+                                               int64_t gap_from,
+                                               int64_t gap_to,
+                                               int64_t tf_ms,
+                                               int64_t page_span) {
+    std::vector<CandleCache::Range> covered;
+    if (candles.empty()) return covered;
+
+    auto close = [&](int64_t from, int64_t last_ts) {
+        int64_t to = std::min(last_ts + std::max<int64_t>(tf_ms, 1) - 1, gap_to);
+        from = std::max(from, gap_from);
+        if (to >= from) covered.emplace_back(from, to);
+    };
+
+    const int64_t first_ts = static_cast<int64_t>(candles.front().timestamp);
+    int64_t span_from = (page_span > 0 && first_ts - gap_from < page_span) ? gap_from : first_ts;
+    int64_t previous = first_ts;
+    for (const auto& candle : candles) {
+        const int64_t ts = static_cast<int64_t>(candle.timestamp);
+        if (page_span > 0 && ts - previous > page_span) {
+            close(span_from, previous);
+            span_from = ts;
+        }
+        previous = ts;
+    }
+    close(span_from, previous);
+    return covered;
+}
+
+} // namespace
+
+std::vector<Candle> Client::fetch_cached_candles(Exchange& exchange,
+                                                 const std::string& instrument_name,
+                                                 const std::string& timeframe,
+                                                 int64_t from_date,
+                                                 int64_t to_date) {
+    const std::string exchange_name = exchange.get_name();
+    const int64_t tf_ms = timeframe_to_ms(timeframe);
+    const int64_t page_span = tf_ms * static_cast<int64_t>(exchange.max_candles_per_request());
+    const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    // The candle still forming is stored but not marked covered, so it is refreshed next time.
+    const int64_t closed_until = tf_ms > 0 ? (now / tf_ms) * tf_ms - 1 : now;
+
+    for (const auto& gap : cache_->missing(exchange_name, instrument_name, timeframe, from_date, to_date)) {
+        std::vector<Candle> candles = fetch_candles_paginated(exchange, instrument_name, timeframe,
+                                                              gap.first, gap.second, *executor_, pages_in_flight_);
+        // Nothing came back (or the exchange failed quietly): leave the gap missing so it is retried.
+        if (candles.empty()) continue;
+        auto covered = covered_ranges(candles, gap.first, std::min(gap.second, closed_until), tf_ms, page_span);
+        cache_->store(exchange_name, instrument_name, timeframe, covered, candles);
+    }
+
+    return cache_->load(exchange_name, instrument_name, timeframe, from_date, to_date);
+}
+
+std::future<std::vector<Instrument>> Client::get_pairs_async(const std::string& exchange_name) {
+    get_exchange(exchange_name);
+    auto task = std::make_shared<std::packaged_task<std::vector<Instrument>()>>([this, exchange_name]() {
+        return get_pairs(exchange_name);
+    });
+    auto future = task->get_future();
+    executor_->post([task]() { (*task)(); });
+    return future;
+}
+
+void Client::get_pairs_async(const std::string& exchange_name, PairsCallback callback) {
+    get_exchange(exchange_name);
+    executor_->post([this, exchange_name, callback]() {
+        std::vector<Instrument> pairs;
+        try {
+            pairs = get_pairs(exchange_name);
+        } catch (...) {
+            callback({}, std::current_exception());
+            return;
+        }
+        callback(std::move(pairs), nullptr);
+    }, [callback]() {
+        callback({}, std::make_exception_ptr(std::runtime_error("Client destroyed before the call started")));
+    });
+}
+
+std::future<std::vector<Candle>> Client::get_historical_candles_async(const std::string& exchange_name,
+                                                                      const std::string& instrument_name,
+                                                                      const std::string& timeframe,
+                                                                      int64_t from_date,
+                                                                      int64_t to_date) {
+    plan_timeframe(*get_exchange(exchange_name), timeframe);
+    auto task = std::make_shared<std::packaged_task<std::vector<Candle>()>>([this, exchange_name, instrument_name, timeframe, from_date, to_date]() {
+        return get_historical_candles(exchange_name, instrument_name, timeframe, from_date, to_date);
+    });
+    auto future = task->get_future();
+    executor_->post([task]() { (*task)(); });
+    return future;
+}
 
-    return exchange->get_historical_candles(instrument_name, timeframe, from_date, actual_to_date);
+void Client::get_historical_candles_async(const std::string& exchange_name,
+                                          const std::string& instrument_name,
+                                          const std::string& timeframe,
+                                          int64_t from_date,
+                                          int64_t to_date,
+                                          CandlesCallback callback) {
+    plan_timeframe(*get_exchange(exchange_name), timeframe);
+    executor_->post([this, exchange_name, instrument_name, timeframe, from_date, to_date, callback]() {
+        std::vector<Candle> candles;
+        try {
+            candles = get_historical_candles(exchange_name, instrument_name, timeframe, from_date, to_date);
+        } catch (...) {
+            callback({}, std::current_exception());
+            return;
+        }
+        callback(std::move(candles), nullptr);
+    }, [callback]() {
+        callback({}, std::make_exception_ptr(std::runtime_error("Client destroyed before the call started")));
+    });
 }
 
 } // namespace nccapi
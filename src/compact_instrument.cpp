@@ -0,0 +1,90 @@
+#include "nccapi/compact_instrument.hpp"
+#include <string>
+
+namespace nccapi {
+
+CompactCatalog CompactCatalog::from_instruments(const std::vector<Instrument>& instruments) {
+    CompactCatalog catalog;
+    catalog.instruments_.reserve(instruments.size());
+    for (const auto& instrument : instruments) {
+        catalog.add(instrument);
+    }
+    return catalog;
+}
+
+void CompactCatalog::add(const Instrument& i) {
+    CompactInstrument c;
+    c.id = symbols_.intern(i.id);
+    c.symbol = symbols_.intern(i.symbol);
+    c.base = symbols_.intern(i.base);
+    c.quote = symbols_.intern(i.quote);
+    c.settle = symbols_.intern(i.settle);
+    c.type = symbols_.intern(i.type);
+    c.underlying = symbols_.intern(i.underlying);
+    c.expiry = symbols_.intern(i.expiry);
+    c.option_type = symbols_.intern(i.option_type);
+    c.active = i.active;
+    c.tick_size = i.tick_size;
+    c.step_size = i.step_size;
+    c.min_size = i.min_size;
+    c.min_notional = i.min_notional;
+    c.contract_multiplier = i.contract_multiplier;
+    c.contract_size = i.contract_size;
+    c.strike_price = i.strike_price;
+    c.maker_fee = i.maker_fee;
+    c.taker_fee = i.taker_fee;
+    instruments_.push_back(c);
+}
+
+Instrument CompactCatalog::expand(size_t index) const {
+    const CompactInstrument& c = instruments_[index];
+    Instrument i;
+    i.id = std::string(name(c.id));
+    i.symbol = std::string(name(c.symbol));
+    i.base = std::string(name(c.base));
+    i.quote = std::string(name(c.quote));
+    i.settle = std::string(name(c.settle));
+    i.type = std::string(name(c.type));
+    i.active = c.active;
+    i.tick_size = c.tick_size;
+    i.step_size = c.step_size;
+    i.min_size = c.min_size;
+    i.min_notional = c.min_notional;
+    i.contract_multiplier = c.contract_multiplier;
+    i.contract_size = c.contract_size;
+    i.underlying = std::string(name(c.underlying));
+    i.expiry = std::string(name(c.expiry));
+    i.strike_price = c.strike_price;
+    i.option_type = std::string(name(c.option_type));
+    i.maker_fee = c.maker_fee;
+    i.taker_fee = c.taker_fee;
+    return i;
+}
+
+std::vector<size_t> CompactCatalog::select(std::string_view base, std::string_view quote, std::string_view type) const {
+    // Resolve each filter to an id once; the scan is then integer compares only.
+    const SymbolId base_id = base.empty() ? SymbolTable::kNotFound : symbols_.find(base);
+    const SymbolId quote_id = quote.empty() ? SymbolTable::kNotFound : symbols_.find(quote);
+    const SymbolId type_id = type.empty() ? SymbolTable::kNotFound : symbols_.find(type);
+
+    std::vector<size_t> rows;
+    if ((!base.empty() && base_id == SymbolTable::kNotFound) ||
+        (!quote.empty() && quote_id == SymbolTable::kNotFound) ||
+        (!type.empty() && type_id == SymbolTable::kNotFound)) {
+        return rows;
+    }
+    for (size_t i = 0; i < instruments_.size(); ++i) {
+        const CompactInstrument& c = instruments_[i];
+        if (!base.empty() && c.base != base_id) continue;
+        if (!quote.empty() && c.quote != quote_id) continue;
+        if (!type.empty() && c.type != type_id) continue;
+        rows.push_back(i);
+    }
+    return rows;
+}
+
+size_t CompactCatalog::memory_usage() const {
+    return instruments_.capacity() * sizeof(CompactInstrument) + symbols_.memory_usage();
+}
+
+} // namespace nccapi
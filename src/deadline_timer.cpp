@@ -0,0 +1,79 @@
+#include "nccapi/deadline_timer.hpp"
+#include <chrono>
+
+namespace nccapi {
+
+DeadlineTimer::DeadlineTimer() : state_(std::make_shared<State>()) {}
+
+DeadlineTimer::~DeadlineTimer() {
+    std::multimap<int64_t, Task> discarded;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+        discarded.swap(state_->tasks);
+    }
+    state_->cv.notify_all();
+    if (!thread_.joinable()) return;
+    if (thread_.get_id() == std::this_thread::get_id()) {
+        // Destroyed from one of its own tasks: the thread exits once the task returns.
+        thread_.detach();
+    } else {
+        thread_.join();
+    }
+}
+
+uint64_t DeadlineTimer::schedule(int64_t deadline_ms, std::function<void()> task) {
+    bool earliest = false;
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->stopping) return 0;
+        earliest = state_->tasks.empty() || deadline_ms < state_->tasks.begin()->first;
+        id = ++state_->next_id;
+        state_->tasks.emplace(deadline_ms, Task{id, std::move(task)});
+        if (!thread_.joinable()) {
+            thread_ = std::thread(run, state_);
+        }
+    }
+    // Only a new earliest deadline shortens the current sleep.
+    if (earliest) state_->cv.notify_one();
+    return id;
+}
+
+void DeadlineTimer::cancel(uint64_t id) {
+    std::function<void()> discarded;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (auto it = state_->tasks.begin(); it != state_->tasks.end(); ++it) {
+        if (it->second.id == id) {
+            // Destroyed after the lock is released: the task may own the last reference to anything.
+            discarded = std::move(it->second.run);
+            state_->tasks.erase(it);
+            return;
+        }
+    }
+}
+
+void DeadlineTimer::run(std::shared_ptr<State> state) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (!state->stopping) {
+        if (state->tasks.empty()) {
+            state->cv.wait(lock);
+            continue;
+        }
+        const std::chrono::system_clock::time_point deadline{std::chrono::milliseconds(state->tasks.begin()->first)};
+        if (std::chrono::system_clock::now() < deadline) {
+            state->cv.wait_until(lock, deadline);
+            continue;
+        }
+
+        std::function<void()> task = std::move(state->tasks.begin()->second.run);
+        state->tasks.erase(state->tasks.begin());
+
+        lock.unlock();
+        task();
+        task = nullptr;
+        lock.lock();
+    }
+}
+
+} // namespace nccapi
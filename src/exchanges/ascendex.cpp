@@ -1,10 +1,13 @@
 #include "nccapi/exchanges/ascendex.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,25 +16,44 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1"},
+        {"5m"_tf, "5"},
+        {"15m"_tf, "15"},
+        {"30m"_tf, "30"},
+        {"1h"_tf, "60"},
+        {"2h"_tf, "120"},
+        {"4h"_tf, "240"},
+        {"6h"_tf, "360"},
+        {"12h"_tf, "720"},
+        {"1d"_tf, "1d"},
+        {"1w"_tf, "1w"},
+        {"1M"_tf, "1m"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Ascendex::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "ascendex");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
@@ -43,22 +65,17 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -67,24 +84,11 @@ public:
                                                int64_t to_date) {
         std::vector<Candle> candles;
 
-        std::string interval = "1";
-        if (timeframe == "1m") interval = "1";
-        else if (timeframe == "5m") interval = "5";
-        else if (timeframe == "15m") interval = "15";
-        else if (timeframe == "30m") interval = "30";
-        else if (timeframe == "1h") interval = "60";
-        else if (timeframe == "2h") interval = "120";
-        else if (timeframe == "4h") interval = "240";
-        else if (timeframe == "6h") interval = "360";
-        else if (timeframe == "12h") interval = "720";
-        else if (timeframe == "1d") interval = "1d";
-        else if (timeframe == "1w") interval = "1w";
-        else if (timeframe == "1M") interval = "1m";
-        else interval = "1";
+        std::string interval(kTimeframes.require(timeframe, "ascendex").code);
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "ascendex", "", "");
 
-        std::string query_string = "symbol=" + instrument_name + "&interval=" + interval;
+        std::string query_string = "symbol=" + instrument_name + "&interval=" + interval + "&n=500";
         if (from_date > 0) query_string += "&from=" + std::to_string(from_date);
         if (to_date > 0) query_string += "&to=" + std::to_string(to_date);
 
@@ -94,11 +98,11 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query_string}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
@@ -114,10 +118,8 @@ public:
                                 */
 
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    // std::cout << "[DEBUG] Body: " << json_str << std::endl;
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
+                                    // std::cout << "[DEBUG] Body: " << element.getValue(CCAPI_HTTP_BODY) << std::endl;
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("data") && doc["data"].IsArray()) {
                                         for (const auto& bar : doc["data"].GetArray()) {
@@ -126,11 +128,14 @@ public:
                                                 Candle candle;
                                                 if (c_obj.HasMember("ts") && c_obj["ts"].IsInt64()) candle.timestamp = c_obj["ts"].GetInt64();
 
-                                                if (c_obj.HasMember("o") && c_obj["o"].IsString()) candle.open = std::stod(c_obj["o"].GetString());
-                                                if (c_obj.HasMember("h") && c_obj["h"].IsString()) candle.high = std::stod(c_obj["h"].GetString());
-                                                if (c_obj.HasMember("l") && c_obj["l"].IsString()) candle.low = std::stod(c_obj["l"].GetString());
-                                                if (c_obj.HasMember("c") && c_obj["c"].IsString()) candle.close = std::stod(c_obj["c"].GetString());
-                                                if (c_obj.HasMember("v") && c_obj["v"].IsString()) candle.volume = std::stod(c_obj["v"].GetString());
+                                                // A malformed or missing field drops the row rather than zero-filling it.
+                                                auto field = [&c_obj](const char* name, double& out) {
+                                                    return c_obj.HasMember(name) && c_obj[name].IsString() && parse_decimal(c_obj[name].GetString(), out);
+                                                };
+                                                if (!field("o", candle.open) || !field("h", candle.high) || !field("l", candle.low) ||
+                                                    !field("c", candle.close) || !field("v", candle.volume)) {
+                                                    continue;
+                                                }
 
                                                 candles.push_back(candle);
                                             }
@@ -159,7 +164,6 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -182,4 +186,8 @@ std::vector<Candle> Ascendex::get_historical_candles(const std::string& instrume
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Ascendex::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
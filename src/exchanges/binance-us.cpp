@@ -1,10 +1,13 @@
 #include "nccapi/exchanges/binance-us.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,55 +16,80 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "60"},
+        {"3m"_tf, "180"},
+        {"5m"_tf, "300"},
+        {"15m"_tf, "900"},
+        {"30m"_tf, "1800"},
+        {"1h"_tf, "3600"},
+        {"2h"_tf, "7200"},
+        {"4h"_tf, "14400"},
+        {"6h"_tf, "21600"},
+        {"8h"_tf, "28800"},
+        {"12h"_tf, "43200"},
+        {"1d"_tf, "86400"},
+        {"3d"_tf, "259200"},
+        {"1w"_tf, "604800"},
+        {"1M"_tf, "2592000"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class BinanceUs::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "binance-us", "", "");
         request.appendParam({
             {CCAPI_HTTP_PATH, "/api/v3/exchangeInfo"},
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("symbols")) {
                                         const auto& symbols = doc["symbols"];
                                         if (symbols.IsArray()) {
+                                            catalog.reserve(symbols.Size());
                                             for (const auto& s : symbols.GetArray()) {
-                                                Instrument instrument;
+                                                Instrument& instrument = catalog.emplace();
                                                 instrument.id = s["symbol"].GetString();
                                                 instrument.base = s["baseAsset"].GetString();
                                                 instrument.quote = s["quoteAsset"].GetString();
 
+                                                bool valid = true; // A malformed filter drops the instrument
                                                 if (s.HasMember("filters") && s["filters"].IsArray()) {
                                                     for (const auto& f : s["filters"].GetArray()) {
                                                         std::string filterType = f["filterType"].GetString();
                                                         if (filterType == "PRICE_FILTER") {
-                                                            instrument.tick_size = std::stod(f["tickSize"].GetString());
+                                                            valid = valid && parse_optional_decimal(f["tickSize"].GetString(), instrument.tick_size);
                                                         } else if (filterType == "LOT_SIZE") {
-                                                            instrument.step_size = std::stod(f["stepSize"].GetString());
-                                                            instrument.min_size = std::stod(f["minQty"].GetString());
+                                                            valid = valid && parse_optional_decimal(f["stepSize"].GetString(), instrument.step_size) &&
+                                                                    parse_optional_decimal(f["minQty"].GetString(), instrument.min_size);
                                                         } else if (filterType == "NOTIONAL") {
-                                                            instrument.min_notional = std::stod(f["minNotional"].GetString());
+                                                            valid = valid && parse_optional_decimal(f["minNotional"].GetString(), instrument.min_notional);
                                                         }
                                                     }
                                                 }
+                                                if (!valid) {
+                                                    catalog.discard();
+                                                    continue;
+                                                }
 
                                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -73,23 +101,20 @@ public:
                                                 if (s.HasMember("status")) {
                                                     instrument.active = (std::string(s["status"].GetString()) == "TRADING");
                                                 }
-
-                                                instruments.push_back(instrument);
                                             }
-                                            return instruments;
+                                            return catalog.finish();
                                         }
                                     }
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                             return instruments;
+                             return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -101,17 +126,17 @@ public:
         ccapi::Request request(ccapi::Request::Operation::GET_HISTORICAL_CANDLESTICKS, "binance-us", instrument_name);
 
         request.appendParam({
-            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::to_string(timeframeToSeconds(timeframe))},
+            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::string(kTimeframes.require(timeframe, "binance-us").code)},
             {CCAPI_START_TIME_SECONDS, std::to_string(from_date / 1000)},
             {CCAPI_END_TIME_SECONDS, std::to_string(to_date / 1000)},
             {CCAPI_LIMIT, "1000"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
@@ -122,11 +147,14 @@ public:
                                 candle.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
                                     message.getTime().time_since_epoch()).count();
 
-                                candle.open = std::stod(element.getValue(CCAPI_OPEN_PRICE));
-                                candle.high = std::stod(element.getValue(CCAPI_HIGH_PRICE));
-                                candle.low = std::stod(element.getValue(CCAPI_LOW_PRICE));
-                                candle.close = std::stod(element.getValue(CCAPI_CLOSE_PRICE));
-                                candle.volume = std::stod(element.getValue(CCAPI_VOLUME));
+                                // A malformed or missing field drops the row rather than zero-filling it.
+                                if (!parse_decimal(element.getValue(CCAPI_OPEN_PRICE), candle.open) ||
+                                    !parse_decimal(element.getValue(CCAPI_HIGH_PRICE), candle.high) ||
+                                    !parse_decimal(element.getValue(CCAPI_LOW_PRICE), candle.low) ||
+                                    !parse_decimal(element.getValue(CCAPI_CLOSE_PRICE), candle.close) ||
+                                    !parse_decimal(element.getValue(CCAPI_VOLUME), candle.volume)) {
+                                    continue;
+                                }
 
                                 candles.push_back(candle);
                             }
@@ -142,30 +170,10 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
 
-    int timeframeToSeconds(const std::string& timeframe) {
-        if (timeframe == "1m") return 60;
-        if (timeframe == "3m") return 180;
-        if (timeframe == "5m") return 300;
-        if (timeframe == "15m") return 900;
-        if (timeframe == "30m") return 1800;
-        if (timeframe == "1h") return 3600;
-        if (timeframe == "2h") return 7200;
-        if (timeframe == "4h") return 14400;
-        if (timeframe == "6h") return 21600;
-        if (timeframe == "8h") return 28800;
-        if (timeframe == "12h") return 43200;
-        if (timeframe == "1d") return 86400;
-        if (timeframe == "3d") return 259200;
-        if (timeframe == "1w") return 604800;
-        if (timeframe == "1M") return 2592000;
-        return 60;
-    }
-
 private:
     std::shared_ptr<UnifiedSession> session;
 };
@@ -184,4 +192,8 @@ std::vector<Candle> BinanceUs::get_historical_candles(const std::string& instrum
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable BinanceUs::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
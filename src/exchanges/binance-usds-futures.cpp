@@ -1,9 +1,11 @@
 #include "nccapi/exchanges/binance-usds-futures.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
@@ -11,37 +13,59 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "60"},
+        {"3m"_tf, "180"},
+        {"5m"_tf, "300"},
+        {"15m"_tf, "900"},
+        {"30m"_tf, "1800"},
+        {"1h"_tf, "3600"},
+        {"2h"_tf, "7200"},
+        {"4h"_tf, "14400"},
+        {"6h"_tf, "21600"},
+        {"8h"_tf, "28800"},
+        {"12h"_tf, "43200"},
+        {"1d"_tf, "86400"},
+        {"3d"_tf, "259200"},
+        {"1w"_tf, "604800"},
+        {"1M"_tf, "2592000"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class BinanceUsdsFutures::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "binance-usds-futures");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 // USDS-M Futures often implies quote is USDT or BUSD.
                                 // For linear futures, contract size is usually 1, but we check if provided.
@@ -57,22 +81,17 @@ public:
                                     instrument.active = (element.getValue(CCAPI_INSTRUMENT_STATUS) == "TRADING");
                                 }
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                             return instruments;
+                             return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -84,17 +103,17 @@ public:
         ccapi::Request request(ccapi::Request::Operation::GET_HISTORICAL_CANDLESTICKS, "binance-usds-futures", instrument_name);
 
         request.appendParam({
-            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::to_string(timeframeToSeconds(timeframe))},
+            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::string(kTimeframes.require(timeframe, "binance-usds-futures").code)},
             {CCAPI_START_TIME_SECONDS, std::to_string(from_date / 1000)},
             {CCAPI_END_TIME_SECONDS, std::to_string(to_date / 1000)},
             {CCAPI_LIMIT, "1000"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
@@ -105,11 +124,14 @@ public:
                                 candle.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
                                     message.getTime().time_since_epoch()).count();
 
-                                candle.open = std::stod(element.getValue(CCAPI_OPEN_PRICE));
-                                candle.high = std::stod(element.getValue(CCAPI_HIGH_PRICE));
-                                candle.low = std::stod(element.getValue(CCAPI_LOW_PRICE));
-                                candle.close = std::stod(element.getValue(CCAPI_CLOSE_PRICE));
-                                candle.volume = std::stod(element.getValue(CCAPI_VOLUME));
+                                // A malformed or missing field drops the row rather than zero-filling it.
+                                if (!parse_decimal(element.getValue(CCAPI_OPEN_PRICE), candle.open) ||
+                                    !parse_decimal(element.getValue(CCAPI_HIGH_PRICE), candle.high) ||
+                                    !parse_decimal(element.getValue(CCAPI_LOW_PRICE), candle.low) ||
+                                    !parse_decimal(element.getValue(CCAPI_CLOSE_PRICE), candle.close) ||
+                                    !parse_decimal(element.getValue(CCAPI_VOLUME), candle.volume)) {
+                                    continue;
+                                }
 
                                 candles.push_back(candle);
                             }
@@ -125,30 +147,10 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
 
-    int timeframeToSeconds(const std::string& timeframe) {
-        if (timeframe == "1m") return 60;
-        if (timeframe == "3m") return 180;
-        if (timeframe == "5m") return 300;
-        if (timeframe == "15m") return 900;
-        if (timeframe == "30m") return 1800;
-        if (timeframe == "1h") return 3600;
-        if (timeframe == "2h") return 7200;
-        if (timeframe == "4h") return 14400;
-        if (timeframe == "6h") return 21600;
-        if (timeframe == "8h") return 28800;
-        if (timeframe == "12h") return 43200;
-        if (timeframe == "1d") return 86400;
-        if (timeframe == "3d") return 259200;
-        if (timeframe == "1w") return 604800;
-        if (timeframe == "1M") return 2592000;
-        return 60;
-    }
-
 private:
     std::shared_ptr<UnifiedSession> session;
 };
@@ -167,4 +169,8 @@ std::vector<Candle> BinanceUsdsFutures::get_historical_candles(const std::string
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable BinanceUsdsFutures::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
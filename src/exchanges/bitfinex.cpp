@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/bitfinex.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,37 +18,56 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"3h"_tf, "3h"},
+        {"6h"_tf, "6h"},
+        {"12h"_tf, "12h"},
+        {"1d"_tf, "1D"},
+        {"1w"_tf, "7D"},
+        {"2w"_tf, "14D"},
+        {"1M"_tf, "1M"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Bitfinex::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "bitfinex");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -53,22 +76,17 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -82,19 +100,7 @@ public:
         std::string symbol = instrument_name;
         if (symbol.size() > 0 && symbol[0] != 't') symbol = "t" + symbol; // Ensure 't' prefix for trading pairs
 
-        std::string tf = "1m";
-        if (timeframe == "1m") tf = "1m";
-        else if (timeframe == "5m") tf = "5m";
-        else if (timeframe == "15m") tf = "15m";
-        else if (timeframe == "30m") tf = "30m";
-        else if (timeframe == "1h") tf = "1h";
-        else if (timeframe == "3h") tf = "3h";
-        else if (timeframe == "6h") tf = "6h";
-        else if (timeframe == "12h") tf = "12h";
-        else if (timeframe == "1d") tf = "1D";
-        else if (timeframe == "1w") tf = "7D";
-        else if (timeframe == "2w") tf = "14D";
-        else if (timeframe == "1M") tf = "1M";
+        std::string tf(kTimeframes.require(timeframe, "bitfinex").code);
 
         std::string path = "/v2/candles/trade:" + tf + ":" + symbol + "/hist";
 
@@ -109,37 +115,18 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                // [ MTS, OPEN, CLOSE, HIGH, LOW, VOLUME ]
-                                                candle.timestamp = item[0].GetInt64();
-                                                candle.open = item[1].GetDouble();
-                                                candle.close = item[2].GetDouble();
-                                                candle.high = item[3].GetDouble();
-                                                candle.low = item[4].GetDouble();
-                                                candle.volume = item[5].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kBitfinex>(http_body(element), candles);
                                 }
                             }
 
@@ -161,7 +148,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -184,4 +170,8 @@ std::vector<Candle> Bitfinex::get_historical_candles(const std::string& instrume
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Bitfinex::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
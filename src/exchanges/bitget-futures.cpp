@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/bitget-futures.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,76 +17,87 @@
 
 namespace nccapi {
 
+namespace {
+    // Bitget Futures `granularity`
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1H"},
+        {"4h"_tf, "4H"},
+        {"12h"_tf, "12H"},
+        {"1d"_tf, "1D"},
+        {"1w"_tf, "1W"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class BitgetFutures::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
-    std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) {
+        CatalogBuilder catalog(session->infoMode());
         // Restore Native GET_INSTRUMENTS which worked (644 pairs)
         std::vector<std::string> productTypes = {"USDT-FUTURES", "COIN-FUTURES", "USDC-FUTURES"};
 
+        std::vector<ccapi::Request> requests;
         for (const auto& pType : productTypes) {
-             ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "bitget-futures");
-             request.appendParam({{"productType", pType}});
-
-             session->sendRequest(request);
-
-            auto start = std::chrono::steady_clock::now();
-            bool received = false;
-            while (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
-                std::vector<ccapi::Event> events = session->getEventQueue().purge();
-                for (const auto& event : events) {
-                    if (event.getType() == ccapi::Event::Type::RESPONSE) {
-                        for (const auto& message : event.getMessageList()) {
-                            if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
-                                for (const auto& element : message.getElementList()) {
-                                    Instrument instrument;
-                                    instrument.id = element.getValue(CCAPI_INSTRUMENT);
-                                    instrument.base = element.getValue(CCAPI_BASE_ASSET);
-                                    instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
-
-                                    std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                    if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
-
-                                    std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                    if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
-
-                                    std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                    if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
-
-                                    if(element.has(CCAPI_CONTRACT_SIZE)) {
-                                        std::string val = element.getValue(CCAPI_CONTRACT_SIZE);
-                                        if(!val.empty()) { try { instrument.contract_size = std::stod(val); } catch(...) {} }
-                                    }
-
-                                    if (!instrument.base.empty() && !instrument.quote.empty()) {
-                                        instrument.symbol = instrument.base + "/" + instrument.quote;
-                                    } else {
-                                        instrument.symbol = instrument.id;
-                                    }
-                                    instrument.type = "future";
-
-                                    if (element.has(CCAPI_INSTRUMENT_STATUS)) {
-                                        instrument.active = (element.getValue(CCAPI_INSTRUMENT_STATUS) == "normal");
-                                    }
-
-                                    for (const auto& pair : element.getNameValueMap()) {
-                                        instrument.info[std::string(pair.first)] = pair.second;
-                                    }
-
-                                    instruments.push_back(instrument);
-                                }
-                                received = true;
-                            }
+            ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "bitget-futures");
+            request.appendParam({{"productType", pType}});
+            requests.push_back(request);
+        }
+
+        // All product types are fetched concurrently
+        auto result = session->fanOut(requests, std::chrono::seconds(5));
+
+        for (size_t i = 0; i < productTypes.size(); ++i) {
+            for (const auto& message : result.messages[i]) {
+                if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                    catalog.reserve(message.getElementList().size());
+                    for (const auto& element : message.getElementList()) {
+                        Instrument& instrument = catalog.emplace();
+                        instrument.id = element.getValue(CCAPI_INSTRUMENT);
+                        instrument.base = element.getValue(CCAPI_BASE_ASSET);
+                        instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
+
+                        std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
+                        if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
+
+                        std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
+                        if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
+
+                        std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
+                        if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
+
+                        if(element.has(CCAPI_CONTRACT_SIZE)) {
+                            std::string val = element.getValue(CCAPI_CONTRACT_SIZE);
+                            if (!parse_optional_decimal(val, instrument.contract_size)) { catalog.discard(); continue; }
                         }
+
+                        if (!instrument.base.empty() && !instrument.quote.empty()) {
+                            instrument.symbol = instrument.base + "/" + instrument.quote;
+                        } else {
+                            instrument.symbol = instrument.id;
+                        }
+                        instrument.type = "future";
+
+                        if (element.has(CCAPI_INSTRUMENT_STATUS)) {
+                            instrument.active = (element.getValue(CCAPI_INSTRUMENT_STATUS) == "normal");
+                        }
+
+                        catalog.assign_info(instrument, element.getNameValueMap());
                     }
                 }
-                if(received) break;
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
         }
-        return instruments;
+
+        for (const auto& failure : result.failures) {
+            failures.push_back({"productType=" + productTypes[failure.index], failure.timedOut, failure.reason});
+        }
+
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -93,18 +108,7 @@ public:
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "bitget-futures", "", "");
 
-        // Bitget Futures Granularity: 1m, 5m, 15m, 30m, 1H, 4H, 12H, 1D, 1W
-        std::string granularity = "1m";
-        if (timeframe == "1m") granularity = "1m";
-        else if (timeframe == "5m") granularity = "5m";
-        else if (timeframe == "15m") granularity = "15m";
-        else if (timeframe == "30m") granularity = "30m";
-        else if (timeframe == "1h") granularity = "1H";
-        else if (timeframe == "4h") granularity = "4H";
-        else if (timeframe == "12h") granularity = "12H";
-        else if (timeframe == "1d") granularity = "1D";
-        else if (timeframe == "1w") granularity = "1W";
-        else granularity = "1m";
+        std::string granularity(kTimeframes.require(timeframe, "bitget-futures").code);
 
         std::string symbol = instrument_name;
         // Strip suffixes if they exist from V1 IDs (e.g. BTCUSDT_UMCBL -> BTCUSDT)
@@ -125,7 +129,7 @@ public:
             productType = "COIN-FUTURES";
         }
 
-        std::string query_string = "symbol=" + symbol + "&granularity=" + granularity + "&productType=" + productType;
+        std::string query_string = "symbol=" + symbol + "&granularity=" + granularity + "&productType=" + productType + "&limit=1000";
         if (from_date > 0) query_string += "&startTime=" + std::to_string(from_date);
         if (to_date > 0) query_string += "&endTime=" + std::to_string(to_date);
 
@@ -135,39 +139,18 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query_string}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    // Bitget V2 returns Object with "data" array (array of arrays)
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("data") && doc["data"].IsArray()) {
-                                        for (const auto& item : doc["data"].GetArray()) {
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                candle.timestamp = std::stoll(item[0].GetString());
-                                                candle.open = std::stod(item[1].GetString());
-                                                candle.high = std::stod(item[2].GetString());
-                                                candle.low = std::stod(item[3].GetString());
-                                                candle.close = std::stod(item[4].GetString());
-                                                candle.volume = std::stod(item[5].GetString()); // Base volume
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    } else {
-                                        // std::cout << "[DEBUG] Bitget Futures Parse Error or No Data: " << json_str << std::endl;
-                                    }
+                                    decode_klines<kline_layouts::kBitgetFutures>(http_body(element), candles);
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
@@ -190,7 +173,6 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -203,7 +185,14 @@ BitgetFutures::BitgetFutures(std::shared_ptr<UnifiedSession> session) : pimpl(st
 BitgetFutures::~BitgetFutures() = default;
 
 std::vector<Instrument> BitgetFutures::get_instruments() {
-    return pimpl->get_instruments();
+    std::vector<PartialFailure> failures;
+    std::vector<Instrument> instruments = pimpl->get_instruments(failures);
+    warn_partial_failures(get_name(), failures);
+    return instruments;
+}
+
+std::vector<Instrument> BitgetFutures::get_instruments(std::vector<PartialFailure>& failures) {
+    return pimpl->get_instruments(failures);
 }
 
 std::vector<Candle> BitgetFutures::get_historical_candles(const std::string& instrument_name,
@@ -213,4 +202,8 @@ std::vector<Candle> BitgetFutures::get_historical_candles(const std::string& ins
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable BitgetFutures::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
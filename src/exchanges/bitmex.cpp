@@ -1,10 +1,12 @@
 #include "nccapi/exchanges/bitmex.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -17,39 +19,62 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
 namespace nccapi {
 
+namespace {
+    // Bitmex binSize
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"1h"_tf, "1h"},
+        {"1d"_tf, "1d"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+
+    std::string timestamp_to_iso8601(int64_t timestamp_ms) {
+        std::time_t t = timestamp_ms / 1000;
+        std::tm tm;
+        gmtime_r(&t, &tm);
+        std::stringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S") << "." << std::setw(3) << std::setfill('0') << (timestamp_ms % 1000) << "Z";
+        return ss.str();
+    }
+}
+
 class Bitmex::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "bitmex", "", "");
         request.appendParam({
             {CCAPI_HTTP_PATH, "/api/v1/instrument/active"},
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsArray()) {
+                                        catalog.reserve(doc.Size());
                                         for (const auto& s : doc.GetArray()) {
-                                            Instrument instrument;
                                             if (!s.HasMember("symbol")) continue;
+                                            Instrument& instrument = catalog.emplace();
 
                                             instrument.id = s["symbol"].GetString();
 
@@ -92,29 +117,32 @@ public:
                                             }
 
                                             // Populate Info
-                                            for (auto& m : s.GetObject()) {
-                                                if (m.value.IsString()) {
-                                                    instrument.info[m.name.GetString()] = m.value.GetString();
-                                                } else if (m.value.IsNumber()) {
-                                                    instrument.info[m.name.GetString()] = std::to_string(m.value.GetDouble());
+                                            if (catalog.info_mode() != InfoMode::Skip) {
+                                                std::pmr::monotonic_buffer_resource scratch = catalog.row_scratch();
+                                                std::pmr::vector<std::pair<std::string_view, std::pmr::string>> fields(&scratch);
+                                                fields.reserve(s.MemberCount());
+                                                for (auto& m : s.GetObject()) {
+                                                    if (m.value.IsString()) {
+                                                        fields.emplace_back(m.name.GetString(), m.value.GetString());
+                                                    } else if (m.value.IsNumber()) {
+                                                        fields.emplace_back(m.name.GetString(), std::string_view(std::to_string(m.value.GetDouble())));
+                                                    }
                                                 }
+                                                catalog.assign_info(instrument, fields);
                                             }
-
-                                            instruments.push_back(instrument);
                                         }
-                                        return instruments;
+                                        return catalog.finish();
                                     }
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -127,14 +155,16 @@ public:
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "bitmex", "", "");
 
         // Build Query String manually
-        // Bitmex binSize: 1m, 5m, 1h, 1d
-        std::string binSize = "1m";
-        if (timeframe == "1m") binSize = "1m";
-        else if (timeframe == "5m") binSize = "5m";
-        else if (timeframe == "1h") binSize = "1h";
-        else if (timeframe == "1d") binSize = "1d";
-
-        std::string query = "symbol=" + instrument_name + "&binSize=" + binSize + "&count=500&reverse=true";
+        std::string binSize(kTimeframes.require(timeframe, "bitmex").code);
+
+        // With a range, ask for it oldest-first (max 1000 buckets); otherwise the latest 500
+        std::string query = "symbol=" + instrument_name + "&binSize=" + binSize;
+        if (from_date > 0) {
+            query += "&count=1000&reverse=false&startTime=" + timestamp_to_iso8601(from_date);
+            if (to_date > 0) query += "&endTime=" + timestamp_to_iso8601(to_date);
+        } else {
+            query += "&count=500&reverse=true";
+        }
 
         request.appendParam({
             {CCAPI_HTTP_PATH, "/api/v1/trade/bucketed"},
@@ -142,19 +172,17 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
-                                std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                rapidjson::Document doc;
-                                doc.Parse(json_content.c_str());
+                                const rapidjson::Document& doc = parse_http_body(element);
 
                                 if (!doc.HasParseError() && doc.IsArray()) {
                                     for (const auto& kline : doc.GetArray()) {
@@ -195,7 +223,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -218,4 +245,8 @@ std::vector<Candle> Bitmex::get_historical_candles(const std::string& instrument
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Bitmex::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
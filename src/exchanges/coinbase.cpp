@@ -1,13 +1,17 @@
 #include "nccapi/exchanges/coinbase.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <cmath>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -17,23 +21,24 @@
 namespace nccapi {
 
 namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "60"},
+        {"5m"_tf, "300"},
+        {"15m"_tf, "900"},
+        {"1h"_tf, "3600"},
+        {"6h"_tf, "21600"},
+        {"1d"_tf, "86400"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+
     std::string timestamp_to_iso8601(int64_t timestamp_ms) {
         std::time_t t = timestamp_ms / 1000;
-        std::tm tm = *std::gmtime(&t); // gmtime is not thread-safe but ok for this context usually. Use gmtime_r if needed.
+        std::tm tm;
+        gmtime_r(&t, &tm); // Paginated fetches format timestamps from several threads at once
         std::stringstream ss;
         ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
         return ss.str();
     }
-
-    int64_t get_timeframe_ms(const std::string& timeframe) {
-        if (timeframe == "1m") return 60000;
-        if (timeframe == "5m") return 300000;
-        if (timeframe == "15m") return 900000;
-        if (timeframe == "1h") return 3600000;
-        if (timeframe == "6h") return 21600000;
-        if (timeframe == "1d") return 86400000;
-        return 60000;
-    }
 }
 
 class Coinbase::Impl {
@@ -41,37 +46,39 @@ public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "coinbase", "", "");
         request.appendParam({
             {CCAPI_HTTP_PATH, "/products"},
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsArray()) {
+                                        catalog.reserve(doc.Size());
                                         for (const auto& item : doc.GetArray()) {
-                                            Instrument instrument;
+                                            Instrument& instrument = catalog.emplace();
                                             instrument.id = item["id"].GetString();
                                             instrument.base = item["base_currency"].GetString();
                                             instrument.quote = item["quote_currency"].GetString();
 
-                                            if (item.HasMember("quote_increment")) instrument.tick_size = std::stod(item["quote_increment"].GetString());
-                                            if (item.HasMember("base_increment")) instrument.step_size = std::stod(item["base_increment"].GetString());
+                                            if ((item.HasMember("quote_increment") && !parse_optional_decimal(item["quote_increment"].GetString(), instrument.tick_size)) ||
+                                                (item.HasMember("base_increment") && !parse_optional_decimal(item["base_increment"].GetString(), instrument.step_size))) {
+                                                catalog.discard();
+                                                continue;
+                                            }
 
                                             if (!instrument.base.empty() && !instrument.quote.empty()) {
                                                 instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -83,22 +90,19 @@ public:
                                             if (item.HasMember("status")) {
                                                 instrument.active = (std::string(item["status"].GetString()) == "online");
                                             }
-
-                                            instruments.push_back(instrument);
                                         }
-                                        return instruments;
+                                        return catalog.finish();
                                     }
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -109,19 +113,13 @@ public:
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "coinbase", "", "");
 
-        std::string granularity = "60";
-        if (timeframe == "1m") granularity = "60";
-        else if (timeframe == "5m") granularity = "300";
-        else if (timeframe == "15m") granularity = "900";
-        else if (timeframe == "1h") granularity = "3600";
-        else if (timeframe == "6h") granularity = "21600";
-        else if (timeframe == "1d") granularity = "86400";
-        else granularity = "60";
+        const NativeTimeframe& native = kTimeframes.require(timeframe, "coinbase");
+        std::string granularity(native.code);
 
         std::string path = "/products/" + instrument_name + "/candles";
 
         // Floor start time to align with granularity to ensure inclusion
-        int64_t tf_ms = get_timeframe_ms(timeframe);
+        int64_t tf_ms = native.timeframe.ms();
         int64_t adjusted_from = from_date;
         if (adjusted_from > 0) {
             adjusted_from = (adjusted_from / tf_ms) * tf_ms;
@@ -142,36 +140,18 @@ public:
 
         request.appendParam(params);
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                candle.timestamp = item[0].GetInt64() * 1000;
-                                                candle.low = item[1].GetDouble();
-                                                candle.high = item[2].GetDouble();
-                                                candle.open = item[3].GetDouble();
-                                                candle.close = item[4].GetDouble();
-                                                candle.volume = item[5].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kCoinbase>(http_body(element), candles);
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
@@ -189,7 +169,6 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -212,4 +191,8 @@ std::vector<Candle> Coinbase::get_historical_candles(const std::string& instrume
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Coinbase::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,11 +1,15 @@
 #include "nccapi/exchanges/cryptocom.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -15,37 +19,56 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"4h"_tf, "4h"},
+        {"6h"_tf, "6h"},
+        {"12h"_tf, "12h"},
+        {"1d"_tf, "1D"},
+        {"1w"_tf, "7D"},
+        {"2w"_tf, "14D"},
+        {"1M"_tf, "1M"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Cryptocom::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "cryptocom");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -54,22 +77,17 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -82,19 +100,7 @@ public:
         // Crypto.com generic path: /v2/public/get-candlestick
         // Params in QUERY STRING for GET
 
-        std::string period = "1m";
-        if (timeframe == "1m") period = "1m";
-        else if (timeframe == "5m") period = "5m";
-        else if (timeframe == "15m") period = "15m";
-        else if (timeframe == "30m") period = "30m";
-        else if (timeframe == "1h") period = "1h";
-        else if (timeframe == "4h") period = "4h";
-        else if (timeframe == "6h") period = "6h";
-        else if (timeframe == "12h") period = "12h";
-        else if (timeframe == "1d") period = "1D";
-        else if (timeframe == "1w") period = "7D";
-        else if (timeframe == "2w") period = "14D";
-        else if (timeframe == "1M") period = "1M";
+        std::string period(kTimeframes.require(timeframe, "cryptocom").code);
 
         std::string query = "instrument_name=" + instrument_name + "&timeframe=" + period;
 
@@ -104,45 +110,18 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("result") && doc["result"].HasMember("data")) {
-                                        const auto& data = doc["result"]["data"];
-                                        for (const auto& item : data.GetArray()) {
-                                            if (item.IsObject()) {
-                                                Candle candle;
-                                                if (item.HasMember("t")) candle.timestamp = item["t"].GetInt64();
-
-                                                auto getVal = [](const rapidjson::Value& v) -> double {
-                                                    if(v.IsString()) return std::stod(v.GetString());
-                                                    if(v.IsDouble()) return v.GetDouble();
-                                                    if(v.IsInt64()) return (double)v.GetInt64();
-                                                    return 0.0;
-                                                };
-
-                                                if (item.HasMember("o")) candle.open = getVal(item["o"]);
-                                                if (item.HasMember("h")) candle.high = getVal(item["h"]);
-                                                if (item.HasMember("l")) candle.low = getVal(item["l"]);
-                                                if (item.HasMember("c")) candle.close = getVal(item["c"]);
-                                                if (item.HasMember("v")) candle.volume = getVal(item["v"]);
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kCryptocom>(http_body(element), candles);
                                 }
                             }
 
@@ -165,7 +144,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -188,4 +166,8 @@ std::vector<Candle> Cryptocom::get_historical_candles(const std::string& instrum
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Cryptocom::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,11 +1,15 @@
 #include "nccapi/exchanges/deribit.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 #include <vector>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,98 +18,126 @@
 
 namespace nccapi {
 
+namespace {
+    // Deribit resolution (minutes, or 1D)
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1"},
+        {"3m"_tf, "3"},
+        {"5m"_tf, "5"},
+        {"10m"_tf, "10"},
+        {"15m"_tf, "15"},
+        {"30m"_tf, "30"},
+        {"1h"_tf, "60"},
+        {"2h"_tf, "120"},
+        {"3h"_tf, "180"},
+        {"6h"_tf, "360"},
+        {"12h"_tf, "720"},
+        {"1d"_tf, "1D"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Deribit::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
-    std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) {
+        CatalogBuilder catalog(session->infoMode());
         // Deribit requires iterating over currencies and kinds
         std::vector<std::string> currencies = {"BTC", "ETH", "USDC", "USDT", "SOL", "EUR", "XRP", "MATIC", "LTC"};
         std::vector<std::string> kinds = {"future", "option", "spot"};
 
+        // Spot only supports specific currency pairs, but Deribit API is flexible.
+        // However, asking for kind='spot' with currency='BTC' returns BTC_USDC etc.
+        std::vector<std::pair<std::string, std::string>> combinations;
+        std::vector<ccapi::Request> requests;
         for (const auto& currency : currencies) {
             for (const auto& kind : kinds) {
-                // Spot only supports specific currency pairs, but Deribit API is flexible.
-                // However, asking for kind='spot' with currency='BTC' returns BTC_USDC etc.
-
                 ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "deribit");
                 request.appendParam({
                     {"currency", currency},
                     {"kind", kind}
                 });
+                requests.push_back(request);
+                combinations.emplace_back(currency, kind);
+            }
+        }
 
-                session->sendRequest(request);
-
-                auto start = std::chrono::steady_clock::now();
-                bool received = false;
-                // Short timeout per request to avoid hanging too long on empty sets
-                while (std::chrono::steady_clock::now() - start < std::chrono::seconds(3)) {
-                    std::vector<ccapi::Event> events = session->getEventQueue().purge();
-                    for (const auto& event : events) {
-                        if (event.getType() == ccapi::Event::Type::RESPONSE) {
-                            for (const auto& message : event.getMessageList()) {
-                                if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
-                                    for (const auto& element : message.getElementList()) {
-                                        Instrument instrument;
-                                        instrument.id = element.getValue(CCAPI_INSTRUMENT);
-                                        instrument.base = element.getValue(CCAPI_BASE_ASSET);
-                                        instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
-
-                                        std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                        if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
-
-                                        std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                        if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
-
-                                        std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                        if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
-
-                                        if (!instrument.base.empty() && !instrument.quote.empty()) {
-                                            instrument.symbol = instrument.base + "/" + instrument.quote;
-                                        } else {
-                                            instrument.symbol = instrument.id;
-                                        }
-                                        instrument.type = kind;
-
-                                        for (const auto& pair : element.getNameValueMap()) {
-                                            instrument.info[std::string(pair.first)] = pair.second;
-                                        }
-
-                                        instruments.push_back(instrument);
-                                    }
-                                    received = true;
-                                } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                                     // Likely "currency not supported" or similar, ignore
-                                     received = true; // Break loop
-                                }
-                            }
+        // All currency/kind combinations are fetched concurrently
+        auto result = session->fanOut(requests, std::chrono::seconds(3));
+
+        for (size_t i = 0; i < combinations.size(); ++i) {
+            const auto& kind = combinations[i].second;
+            for (const auto& message : result.messages[i]) {
+                if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                    catalog.reserve(message.getElementList().size());
+                    for (const auto& element : message.getElementList()) {
+                        Instrument& instrument = catalog.emplace();
+                        instrument.id = element.getValue(CCAPI_INSTRUMENT);
+                        instrument.base = element.getValue(CCAPI_BASE_ASSET);
+                        instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
+
+                        std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
+                        if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
+
+                        std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
+                        if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
+
+                        std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
+                        if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
+
+                        if (!instrument.base.empty() && !instrument.quote.empty()) {
+                            instrument.symbol = instrument.base + "/" + instrument.quote;
+                        } else {
+                            instrument.symbol = instrument.id;
                         }
+                        instrument.type = kind;
+
+                        catalog.assign_info(instrument, element.getNameValueMap());
                     }
-                    if (received) break;
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
                 }
             }
         }
-        return instruments;
+
+        for (const auto& failure : result.failures) {
+            // Error responses are expected ("currency not supported" for some kinds); only report timeouts
+            if (!failure.timedOut) continue;
+            failures.push_back({"currency=" + combinations[failure.index].first + " kind=" + combinations[failure.index].second,
+                                failure.timedOut, failure.reason});
+        }
+
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
 
         // Deribit Generic Request
         // Endpoint: /api/v2/public/get_tradingview_chart_data
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "deribit", "", "");
 
-        // Deribit resolution: 1, 3, 5, 10, 15, 30, 60, 120, 180, 360, 720, 1D
-        std::string resolution = "1";
-        if (timeframe == "1m") resolution = "1";
-        else if (timeframe == "5m") resolution = "5";
-        else if (timeframe == "1h") resolution = "60";
-        else if (timeframe == "1d") resolution = "1D";
+        std::string resolution(kTimeframes.require(timeframe, "deribit").code);
 
         std::string query = "instrument_name=" + instrument_name + "&resolution=" + resolution;
         if (from_date > 0) {
@@ -121,43 +153,19 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("result") && doc["result"].IsObject()) {
-                                        const auto& res = doc["result"];
-                                        if (res.HasMember("ticks") && res["ticks"].IsArray()) {
-                                            const auto& ticks = res["ticks"];
-                                            const auto& opens = res["open"];
-                                            const auto& highs = res["high"];
-                                            const auto& lows = res["low"];
-                                            const auto& closes = res["close"];
-                                            const auto& volumes = res["volume"];
-
-                                            for (size_t i = 0; i < ticks.Size(); ++i) {
-                                                Candle candle;
-                                                candle.timestamp = ticks[i].GetInt64();
-                                                candle.open = opens[i].GetDouble();
-                                                candle.high = highs[i].GetDouble();
-                                                candle.low = lows[i].GetDouble();
-                                                candle.close = closes[i].GetDouble();
-                                                candle.volume = volumes[i].GetDouble();
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                        std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                                    if (decode_klines<kline_layouts::kDeribit>(http_body(element), scale, candles)) {
+                                        std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                                             return a.timestamp < b.timestamp;
                                         });
                                         return candles;
@@ -170,7 +178,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -183,7 +190,14 @@ Deribit::Deribit(std::shared_ptr<UnifiedSession> session) : pimpl(std::make_uniq
 Deribit::~Deribit() = default;
 
 std::vector<Instrument> Deribit::get_instruments() {
-    return pimpl->get_instruments();
+    std::vector<PartialFailure> failures;
+    std::vector<Instrument> instruments = pimpl->get_instruments(failures);
+    warn_partial_failures(get_name(), failures);
+    return instruments;
+}
+
+std::vector<Instrument> Deribit::get_instruments(std::vector<PartialFailure>& failures) {
+    return pimpl->get_instruments(failures);
 }
 
 std::vector<Candle> Deribit::get_historical_candles(const std::string& instrument_name,
@@ -193,4 +207,16 @@ std::vector<Candle> Deribit::get_historical_candles(const std::string& instrumen
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> Deribit::get_historical_fixed_candles(const std::string& instrument_name,
+                                                               const std::string& timeframe,
+                                                               int64_t from_date,
+                                                               int64_t to_date,
+                                                               const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TimeframeTable Deribit::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/gateio-perpetual-futures.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,78 +17,109 @@
 
 namespace nccapi {
 
+namespace {
+    // GateIO futures interval
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"10s"_tf, "10s"},
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"4h"_tf, "4h"},
+        {"8h"_tf, "8h"},
+        {"1d"_tf, "1d"},
+        {"1w"_tf, "7d"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class GateioPerpetualFutures::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
-    std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) {
+        CatalogBuilder catalog(session->infoMode());
         std::vector<std::string> settles = {"usdt", "btc", "usd"}; // Common settlement currencies
 
+        std::vector<ccapi::Request> requests;
         for (const auto& settle : settles) {
             ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "gateio-perpetual-futures");
             request.appendParam({
                 {CCAPI_SETTLE_ASSET, settle}
             });
+            requests.push_back(request);
+        }
 
-            session->sendRequest(request);
-
-            auto start = std::chrono::steady_clock::now();
-            bool received = false;
-            while (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
-                std::vector<ccapi::Event> events = session->getEventQueue().purge();
-                for (const auto& event : events) {
-                    if (event.getType() == ccapi::Event::Type::RESPONSE) {
-                        for (const auto& message : event.getMessageList()) {
-                            if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
-                                for (const auto& element : message.getElementList()) {
-                                    Instrument instrument;
-                                    instrument.id = element.getValue(CCAPI_INSTRUMENT);
-                                    instrument.base = element.getValue(CCAPI_BASE_ASSET);
-                                    instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
-                                    instrument.settle = settle;
-
-                                    std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                    if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
-
-                                    std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                    if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
-
-                                    std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                    if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
-
-                                    instrument.contract_size = 1.0; // GateIO perp usually 1 contract
-
-                                    if (!instrument.base.empty() && !instrument.quote.empty()) {
-                                        instrument.symbol = instrument.base + "/" + instrument.quote;
-                                    } else {
-                                        instrument.symbol = instrument.id;
-                                    }
-                                    instrument.type = "swap"; // Perpetual
+        // All settlement currencies are fetched concurrently
+        auto result = session->fanOut(requests, std::chrono::seconds(5));
 
-                                    for (const auto& pair : element.getNameValueMap()) {
-                                        instrument.info[std::string(pair.first)] = pair.second;
-                                    }
+        for (size_t i = 0; i < settles.size(); ++i) {
+            const auto& settle = settles[i];
+            for (const auto& message : result.messages[i]) {
+                if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                    catalog.reserve(message.getElementList().size());
+                    for (const auto& element : message.getElementList()) {
+                        Instrument& instrument = catalog.emplace();
+                        instrument.id = element.getValue(CCAPI_INSTRUMENT);
+                        instrument.base = element.getValue(CCAPI_BASE_ASSET);
+                        instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
+                        instrument.settle = settle;
 
-                                    instruments.push_back(instrument);
-                                }
-                                received = true;
-                            }
+                        std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
+                        if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
+
+                        std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
+                        if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
+
+                        std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
+                        if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
+
+                        instrument.contract_size = 1.0; // GateIO perp usually 1 contract
+
+                        if (!instrument.base.empty() && !instrument.quote.empty()) {
+                            instrument.symbol = instrument.base + "/" + instrument.quote;
+                        } else {
+                            instrument.symbol = instrument.id;
                         }
+                        instrument.type = "swap"; // Perpetual
+
+                        catalog.assign_info(instrument, element.getNameValueMap());
                     }
                 }
-                if (received) break;
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
         }
-        return instruments;
+
+        for (const auto& failure : result.failures) {
+            failures.push_back({"settle=" + settles[failure.index], failure.timedOut, failure.reason});
+        }
+
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
 
         // GateIO Perp Generic Request
         // Endpoint: /api/v4/futures/{settle}/candlesticks
@@ -102,12 +137,7 @@ public:
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "gateio-perpetual-futures", "", "");
 
-        // GateIO interval: 10s, 1m, 5m, 15m, 30m, 1h, 4h, 8h, 1d, 7d
-        std::string interval = "1m";
-        if (timeframe == "1m") interval = "1m";
-        else if (timeframe == "5m") interval = "5m";
-        else if (timeframe == "1h") interval = "1h";
-        else if (timeframe == "1d") interval = "1d";
+        std::string interval(kTimeframes.require(timeframe, "gateio-perpetual-futures").code);
 
         std::string query = "contract=" + instrument_name + "&interval=" + interval;
         if (from_date > 0) {
@@ -125,36 +155,19 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            if (item.IsObject()) {
-                                                Candle candle;
-                                                if (item.HasMember("t")) candle.timestamp = (int64_t)item["t"].GetInt64() * 1000;
-                                                if (item.HasMember("o")) candle.open = std::stod(item["o"].GetString());
-                                                if (item.HasMember("h")) candle.high = std::stod(item["h"].GetString());
-                                                if (item.HasMember("l")) candle.low = std::stod(item["l"].GetString());
-                                                if (item.HasMember("c")) candle.close = std::stod(item["c"].GetString());
-                                                if (item.HasMember("v")) candle.volume = (double)item["v"].GetInt64(); // Volume is integer number of contracts
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                        std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                                    if (decode_klines<kline_layouts::kGateioPerpetualFutures>(http_body(element), scale, candles)) {
+                                        std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                                             return a.timestamp < b.timestamp;
                                         });
                                         return candles;
@@ -167,7 +180,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -180,7 +192,14 @@ GateioPerpetualFutures::GateioPerpetualFutures(std::shared_ptr<UnifiedSession> s
 GateioPerpetualFutures::~GateioPerpetualFutures() = default;
 
 std::vector<Instrument> GateioPerpetualFutures::get_instruments() {
-    return pimpl->get_instruments();
+    std::vector<PartialFailure> failures;
+    std::vector<Instrument> instruments = pimpl->get_instruments(failures);
+    warn_partial_failures(get_name(), failures);
+    return instruments;
+}
+
+std::vector<Instrument> GateioPerpetualFutures::get_instruments(std::vector<PartialFailure>& failures) {
+    return pimpl->get_instruments(failures);
 }
 
 std::vector<Candle> GateioPerpetualFutures::get_historical_candles(const std::string& instrument_name,
@@ -190,4 +209,16 @@ std::vector<Candle> GateioPerpetualFutures::get_historical_candles(const std::st
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> GateioPerpetualFutures::get_historical_fixed_candles(const std::string& instrument_name,
+                                                                              const std::string& timeframe,
+                                                                              int64_t from_date,
+                                                                              int64_t to_date,
+                                                                              const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TimeframeTable GateioPerpetualFutures::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,15 @@
 #include "nccapi/exchanges/gateio.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
+#include "nccapi/sessions/ticker_decoder.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,37 +18,58 @@
 
 namespace nccapi {
 
+namespace {
+    // GateIO interval
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"10s"_tf, "10s"},
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"4h"_tf, "4h"},
+        {"8h"_tf, "8h"},
+        {"1d"_tf, "1d"},
+        {"1w"_tf, "7d"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+
+    // GET /api/v4/spot/tickers: [{"currency_pair": .., "last": .., "highest_bid": .., "lowest_ask": .., "base_volume": ..}, ...]
+    constexpr TickerLayout kTickers = TickerLayout::objects({}, {{"currency_pair", "last", "highest_bid", "lowest_ask", "base_volume"}});
+}
+
 class Gateio::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "gateio");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -52,44 +78,46 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "gateio", "", "");
 
-        // GateIO timeframe: 10s, 1m, 5m, 15m, 30m, 1h, 4h, 8h, 1d, 7d
-        std::string interval = "1m";
-        if (timeframe == "1m") interval = "1m";
-        else if (timeframe == "5m") interval = "5m";
-        else if (timeframe == "15m") interval = "15m";
-        else if (timeframe == "30m") interval = "30m";
-        else if (timeframe == "1h") interval = "1h";
-        else if (timeframe == "4h") interval = "4h";
-        else if (timeframe == "8h") interval = "8h";
-        else if (timeframe == "1d") interval = "1d";
-        else if (timeframe == "1w") interval = "7d";
-        else interval = "1m";
+        std::string interval(kTimeframes.require(timeframe, "gateio").code);
 
         std::string query_string = "currency_pair=" + instrument_name + "&interval=" + interval;
         if (from_date > 0) query_string += "&from=" + std::to_string(from_date / 1000); // seconds
@@ -101,45 +129,18 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query_string}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            // [ timestamp (sec), volume, close, high, low, open, ... ] (strings)
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                // GateIO Spot:
-                                                // 0: timestamp (string)
-                                                // 1: volume (string)
-                                                // 2: close (string)
-                                                // 3: high (string)
-                                                // 4: low (string)
-                                                // 5: open (string)
-
-                                                candle.timestamp = std::stoll(item[0].GetString()) * 1000;
-                                                candle.volume = std::stod(item[1].GetString());
-                                                candle.close = std::stod(item[2].GetString());
-                                                candle.high = std::stod(item[3].GetString());
-                                                candle.low = std::stod(item[4].GetString());
-                                                candle.open = std::stod(item[5].GetString());
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kGateio>(http_body(element), scale, candles);
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
@@ -150,22 +151,55 @@ public:
             }
             if (!candles.empty()) {
                 if (from_date > 0 || to_date > 0) {
-                    candles.erase(std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Candle& c) {
+                    candles.erase(std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Row& c) {
                         if (from_date > 0 && c.timestamp < from_date) return true;
                         if (to_date > 0 && c.timestamp > to_date) return true;
                         return false;
                     }), candles.end());
                 }
-                std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                     return a.timestamp < b.timestamp;
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
 
+    TickerTable get_tickers() {
+        TickerTable tickers;
+        ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "gateio", "", "");
+        request.appendParam({
+            {CCAPI_HTTP_METHOD, "GET"},
+            {CCAPI_HTTP_PATH, "/api/v4/spot/tickers"}
+        });
+
+        auto pending = session->sendRequest(request);
+
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
+            for (const auto& event : events) {
+                if (event.getType() == ccapi::Event::Type::RESPONSE) {
+                    for (const auto& message : event.getMessageList()) {
+                        if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
+                            for (const auto& element : message.getElementList()) {
+                                if (element.has(CCAPI_HTTP_BODY) && !decode_tickers<kTickers>(http_body(element), "spot", tickers)) {
+                                    std::cerr << "[WARN] gateio: unexpected ticker payload" << std::endl;
+                                    tickers.clear();
+                                }
+                            }
+                            return tickers;
+                        } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
+                            return tickers;
+                        }
+                    }
+                }
+            }
+        }
+        return tickers;
+    }
+
 private:
     std::shared_ptr<UnifiedSession> session;
 };
@@ -184,4 +218,20 @@ std::vector<Candle> Gateio::get_historical_candles(const std::string& instrument
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> Gateio::get_historical_fixed_candles(const std::string& instrument_name,
+                                                              const std::string& timeframe,
+                                                              int64_t from_date,
+                                                              int64_t to_date,
+                                                              const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TickerTable Gateio::get_tickers() {
+    return pimpl->get_tickers();
+}
+
+TimeframeTable Gateio::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,13 @@
 #include "nccapi/exchanges/gemini.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,14 +17,17 @@
 namespace nccapi {
 
 namespace {
-    int64_t get_timeframe_ms(const std::string& timeframe) {
-        if (timeframe == "1m") return 60000;
-        if (timeframe == "5m") return 300000;
-        if (timeframe == "15m") return 900000;
-        if (timeframe == "1h") return 3600000;
-        // ...
-        return 60000;
-    }
+    // Gemini time_frame (path segment)
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1hr"},
+        {"6h"_tf, "6hr"},
+        {"1d"_tf, "1day"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
 }
 
 class Gemini::Impl {
@@ -29,20 +35,21 @@ public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "gemini");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
@@ -56,22 +63,17 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -82,16 +84,8 @@ public:
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "gemini", "", "");
 
-        // Gemini timeframe: 1m, 5m, 15m, 30m, 1h, 6h, 1d
-        std::string tf = "1m";
-        if (timeframe == "1m") tf = "1m";
-        else if (timeframe == "5m") tf = "5m";
-        else if (timeframe == "15m") tf = "15m";
-        else if (timeframe == "30m") tf = "30m";
-        else if (timeframe == "1h") tf = "1hr"; // Gemini uses "1hr"
-        else if (timeframe == "6h") tf = "6hr";
-        else if (timeframe == "1d") tf = "1day";
-        else tf = "1m";
+        const NativeTimeframe& native = kTimeframes.require(timeframe, "gemini");
+        std::string tf(native.code);
 
         std::string path = "/v2/candles/" + instrument_name + "/" + tf;
 
@@ -100,10 +94,10 @@ public:
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         // Adjust from_date for filter
-        int64_t tf_ms = get_timeframe_ms(timeframe);
+        int64_t tf_ms = native.timeframe.ms();
         int64_t adjusted_from = from_date;
         if (adjusted_from > 0) {
             adjusted_from = (adjusted_from / tf_ms) * tf_ms;
@@ -111,33 +105,14 @@ public:
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            // [ time, open, high, low, close, volume ]
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                candle.timestamp = item[0].GetInt64();
-                                                candle.open = item[1].GetDouble();
-                                                candle.high = item[2].GetDouble();
-                                                candle.low = item[3].GetDouble();
-                                                candle.close = item[4].GetDouble();
-                                                candle.volume = item[5].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kGemini>(http_body(element), candles);
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
@@ -160,7 +135,6 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -183,4 +157,8 @@ std::vector<Candle> Gemini::get_historical_candles(const std::string& instrument
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Gemini::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/huobi-usdt-swap.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,36 +18,53 @@
 
 namespace nccapi {
 
+namespace {
+    // Huobi period
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1min"},
+        {"5m"_tf, "5min"},
+        {"15m"_tf, "15min"},
+        {"30m"_tf, "30min"},
+        {"1h"_tf, "60min"},
+        {"4h"_tf, "4hour"},
+        {"1d"_tf, "1day"},
+        {"1w"_tf, "1week"},
+        {"1M"_tf, "1mon"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class HuobiUsdtSwap::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "huobi-usdt-swap");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(10));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 // USDT Swap usually has contract_size
                                 if(element.has(CCAPI_CONTRACT_SIZE)) {
                                      std::string val = element.getValue(CCAPI_CONTRACT_SIZE);
-                                     if(!val.empty()) { try { instrument.contract_size = std::stod(val); } catch(...) {} }
+                                     if (!parse_optional_decimal(val, instrument.contract_size)) { catalog.discard(); continue; }
                                 }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
@@ -54,54 +75,62 @@ public:
 
                                 instrument.type = "swap";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
 
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
 
         // Huobi USDT Swap (Linear)
         // Endpoint: /linear-swap-ex/market/history/kline
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "huobi-usdt-swap", "", "");
 
-        // Huobi period: 1min, 5min, 15min, 30min, 60min, 4hour, 1day, 1mon, 1week, 1year
-        std::string period = "1min";
-        if (timeframe == "1m") period = "1min";
-        else if (timeframe == "5m") period = "5min";
-        else if (timeframe == "15m") period = "15min";
-        else if (timeframe == "30m") period = "30min";
-        else if (timeframe == "1h") period = "60min";
-        else if (timeframe == "4h") period = "4hour";
-        else if (timeframe == "1d") period = "1day";
-        else if (timeframe == "1w") period = "1week";
-        else if (timeframe == "1M") period = "1mon";
-        else period = "1min";
+        std::string period(kTimeframes.require(timeframe, "huobi-usdt-swap").code);
 
         std::string symbol = instrument_name;
         if (symbol.find("-USDT") == std::string::npos) {
             symbol += "-USDT";
         }
 
-        std::string query = "contract_code=" + symbol + "&period=" + period + "&size=2000";
+        // Without from/to Huobi returns the latest `size` candles; with both it returns the range (max 2000)
+        std::string query = "contract_code=" + symbol + "&period=" + period;
+        if (from_date > 0 && to_date > 0) {
+            query += "&from=" + std::to_string(from_date / 1000) + "&to=" + std::to_string(to_date / 1000);
+        } else {
+            query += "&size=2000";
+        }
 
         request.appendParam({
             {CCAPI_HTTP_PATH, "/linear-swap-ex/market/history/kline"},
@@ -109,45 +138,27 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("data") && doc["data"].IsArray()) {
-                                        for (const auto& kline : doc["data"].GetArray()) {
-                                            if (kline.IsObject()) {
-                                                Candle candle;
-                                                if (kline.HasMember("id") && kline["id"].IsInt64()) candle.timestamp = kline["id"].GetInt64() * 1000;
-                                                if (kline.HasMember("open") && kline["open"].IsNumber()) candle.open = kline["open"].GetDouble();
-                                                if (kline.HasMember("high") && kline["high"].IsNumber()) candle.high = kline["high"].GetDouble();
-                                                if (kline.HasMember("low") && kline["low"].IsNumber()) candle.low = kline["low"].GetDouble();
-                                                if (kline.HasMember("close") && kline["close"].IsNumber()) candle.close = kline["close"].GetDouble();
-                                                if (kline.HasMember("vol") && kline["vol"].IsNumber()) candle.volume = kline["vol"].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kHuobiUsdtSwap>(http_body(element), scale, candles);
                                 }
                             }
 
-                            std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                            std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                                 return a.timestamp < b.timestamp;
                             });
 
                             if (from_date > 0 || to_date > 0) {
-                                auto it = std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Candle& c) {
+                                auto it = std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Row& c) {
                                     if (from_date > 0 && c.timestamp < from_date) return true;
                                     if (to_date > 0 && c.timestamp >= to_date) return true;
                                     return false;
@@ -160,7 +171,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -183,4 +193,16 @@ std::vector<Candle> HuobiUsdtSwap::get_historical_candles(const std::string& ins
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> HuobiUsdtSwap::get_historical_fixed_candles(const std::string& instrument_name,
+                                                                     const std::string& timeframe,
+                                                                     int64_t from_date,
+                                                                     int64_t to_date,
+                                                                     const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TimeframeTable HuobiUsdtSwap::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/huobi.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,37 +17,54 @@
 
 namespace nccapi {
 
+namespace {
+    // Huobi period
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1min"},
+        {"5m"_tf, "5min"},
+        {"15m"_tf, "15min"},
+        {"30m"_tf, "30min"},
+        {"1h"_tf, "60min"},
+        {"4h"_tf, "4hour"},
+        {"1d"_tf, "1day"},
+        {"1w"_tf, "1week"},
+        {"1M"_tf, "1mon"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Huobi::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "huobi");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -52,46 +73,48 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
 
         // Huobi Spot Generic Request
         // Endpoint: /market/history/kline
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "huobi", "", "");
 
-        // Huobi period mapping
-        std::string period = "1min";
-        if (timeframe == "1m") period = "1min";
-        else if (timeframe == "5m") period = "5min";
-        else if (timeframe == "15m") period = "15min";
-        else if (timeframe == "30m") period = "30min";
-        else if (timeframe == "1h") period = "60min";
-        else if (timeframe == "4h") period = "4hour";
-        else if (timeframe == "1d") period = "1day";
-        else if (timeframe == "1w") period = "1week";
-        else if (timeframe == "1M") period = "1mon";
-        else period = "1min";
+        std::string period(kTimeframes.require(timeframe, "huobi").code);
 
         std::string query = "symbol=" + instrument_name + "&period=" + period + "&size=2000";
 
@@ -101,43 +124,24 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("data") && doc["data"].IsArray()) {
-                                        for (const auto& item : doc["data"].GetArray()) {
-                                            if (item.IsObject()) {
-                                                Candle candle;
-                                                if (item.HasMember("id")) {
-                                                    candle.timestamp = (int64_t)item["id"].GetInt64() * 1000;
-                                                }
-                                                if (item.HasMember("open")) candle.open = item["open"].GetDouble();
-                                                if (item.HasMember("high")) candle.high = item["high"].GetDouble();
-                                                if (item.HasMember("low")) candle.low = item["low"].GetDouble();
-                                                if (item.HasMember("close")) candle.close = item["close"].GetDouble();
-                                                if (item.HasMember("vol")) candle.volume = item["vol"].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                        std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                                    if (decode_klines<kline_layouts::kHuobi>(http_body(element), scale, candles)) {
+                                        std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                                             return a.timestamp < b.timestamp;
                                         });
 
                                         if (from_date > 0 || to_date > 0) {
-                                            auto it = std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Candle& c) {
+                                            auto it = std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Row& c) {
                                                 if (from_date > 0 && c.timestamp < from_date) return true;
                                                 if (to_date > 0 && c.timestamp >= to_date) return true;
                                                 return false;
@@ -155,7 +159,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -178,4 +181,16 @@ std::vector<Candle> Huobi::get_historical_candles(const std::string& instrument_
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> Huobi::get_historical_fixed_candles(const std::string& instrument_name,
+                                                             const std::string& timeframe,
+                                                             int64_t from_date,
+                                                             int64_t to_date,
+                                                             const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TimeframeTable Huobi::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/kraken-futures.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,39 +18,53 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"4h"_tf, "4h"},
+        {"12h"_tf, "12h"},
+        {"1d"_tf, "1d"},
+        {"1w"_tf, "1w"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class KrakenFutures::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
-        ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "kraken-futures", "", "GET_INSTRUMENTS");
+        CatalogBuilder catalog(session->infoMode());
+        ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "kraken-futures", "", "");
         request.appendParam({
             {CCAPI_HTTP_PATH, "/derivatives/api/v3/instruments"},
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("instruments") && doc["instruments"].IsArray()) {
+                                        catalog.reserve(doc["instruments"].Size());
                                         for (const auto& s : doc["instruments"].GetArray()) {
-                                            Instrument instrument;
+                                            if (!s.HasMember("symbol")) continue;
+                                            Instrument& instrument = catalog.emplace();
 
-                                            if (s.HasMember("symbol")) instrument.id = s["symbol"].GetString();
-                                            else continue;
+                                            instrument.id = s["symbol"].GetString();
 
                                             if (s.HasMember("underlying")) instrument.base = s["underlying"].GetString();
                                             instrument.quote = "USD";
@@ -65,31 +83,34 @@ public:
                                             if (s.HasMember("type")) instrument.type = s["type"].GetString();
 
                                             // Populate Info
-                                            for (auto& m : s.GetObject()) {
-                                                if (m.value.IsString()) {
-                                                    instrument.info[m.name.GetString()] = m.value.GetString();
-                                                } else if (m.value.IsNumber()) {
-                                                    instrument.info[m.name.GetString()] = std::to_string(m.value.GetDouble());
-                                                } else if (m.value.IsBool()) {
-                                                    instrument.info[m.name.GetString()] = m.value.GetBool() ? "true" : "false";
+                                            if (catalog.info_mode() != InfoMode::Skip) {
+                                                std::pmr::monotonic_buffer_resource scratch = catalog.row_scratch();
+                                                std::pmr::vector<std::pair<std::string_view, std::pmr::string>> fields(&scratch);
+                                                fields.reserve(s.MemberCount());
+                                                for (auto& m : s.GetObject()) {
+                                                    if (m.value.IsString()) {
+                                                        fields.emplace_back(m.name.GetString(), m.value.GetString());
+                                                    } else if (m.value.IsNumber()) {
+                                                        fields.emplace_back(m.name.GetString(), std::string_view(std::to_string(m.value.GetDouble())));
+                                                    } else if (m.value.IsBool()) {
+                                                        fields.emplace_back(m.name.GetString(), m.value.GetBool() ? "true" : "false");
+                                                    }
                                                 }
+                                                catalog.assign_info(instrument, fields);
                                             }
-
-                                            instruments.push_back(instrument);
                                         }
-                                        return instruments;
+                                        return catalog.finish();
                                     }
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -107,17 +128,7 @@ public:
         // Let's try "/derivatives/api/v3/instruments" worked for instruments.
         // Let's use "/derivatives/api/v4/charts/trade"
 
-        std::string resolution = "1m";
-        if (timeframe == "1m") resolution = "1m";
-        else if (timeframe == "5m") resolution = "5m";
-        else if (timeframe == "15m") resolution = "15m";
-        else if (timeframe == "30m") resolution = "30m";
-        else if (timeframe == "1h") resolution = "1h";
-        else if (timeframe == "4h") resolution = "4h";
-        else if (timeframe == "12h") resolution = "12h";
-        else if (timeframe == "1d") resolution = "1d";
-        else if (timeframe == "1w") resolution = "1w";
-        else resolution = "1m";
+        std::string resolution(kTimeframes.require(timeframe, "kraken-futures").code);
 
         // URL Encoding check: "PI_XBTUSD" -> "PI_XBTUSD".
 
@@ -136,47 +147,18 @@ public:
              request.appendParam({{"to", std::to_string(to_date / 1000)}});
         }
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("candles") && doc["candles"].IsArray()) {
-                                        for (const auto& kline : doc["candles"].GetArray()) {
-                                            if (kline.IsObject()) {
-                                                Candle candle;
-                                                // time is ms in v4? docs say "time": 1563830000000
-                                                if (kline.HasMember("time") && kline["time"].IsInt64()) candle.timestamp = kline["time"].GetInt64();
-
-                                                if (kline.HasMember("open") && kline["open"].IsString()) candle.open = std::stod(kline["open"].GetString());
-                                                else if (kline.HasMember("open") && kline["open"].IsDouble()) candle.open = kline["open"].GetDouble();
-
-                                                if (kline.HasMember("high") && kline["high"].IsString()) candle.high = std::stod(kline["high"].GetString());
-                                                else if (kline.HasMember("high") && kline["high"].IsDouble()) candle.high = kline["high"].GetDouble();
-
-                                                if (kline.HasMember("low") && kline["low"].IsString()) candle.low = std::stod(kline["low"].GetString());
-                                                else if (kline.HasMember("low") && kline["low"].IsDouble()) candle.low = kline["low"].GetDouble();
-
-                                                if (kline.HasMember("close") && kline["close"].IsString()) candle.close = std::stod(kline["close"].GetString());
-                                                else if (kline.HasMember("close") && kline["close"].IsDouble()) candle.close = kline["close"].GetDouble();
-
-                                                if (kline.HasMember("volume") && kline["volume"].IsString()) candle.volume = std::stod(kline["volume"].GetString());
-                                                else if (kline.HasMember("volume") && kline["volume"].IsNumber()) candle.volume = kline["volume"].GetDouble();
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kKrakenFutures>(http_body(element), candles);
                                 }
                             }
 
@@ -200,7 +182,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -223,4 +204,8 @@ std::vector<Candle> KrakenFutures::get_historical_candles(const std::string& ins
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable KrakenFutures::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/kraken.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,37 +18,53 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1"},
+        {"5m"_tf, "5"},
+        {"15m"_tf, "15"},
+        {"30m"_tf, "30"},
+        {"1h"_tf, "60"},
+        {"4h"_tf, "240"},
+        {"1d"_tf, "1440"},
+        {"1w"_tf, "10080"},
+        {"15d"_tf, "21600"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Kraken::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "kraken");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -53,40 +73,44 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                             return instruments;
+                             return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
                                                const std::string& timeframe,
                                                int64_t from_date,
                                                int64_t to_date) {
-        std::vector<Candle> candles;
-
-        std::string interval = "1";
-        if (timeframe == "1m") interval = "1";
-        else if (timeframe == "5m") interval = "5";
-        else if (timeframe == "15m") interval = "15";
-        else if (timeframe == "30m") interval = "30";
-        else if (timeframe == "1h") interval = "60";
-        else if (timeframe == "4h") interval = "240";
-        else if (timeframe == "1d") interval = "1440";
-        else if (timeframe == "1w") interval = "10080";
-        else interval = "1";
+        return fetch_candles<Candle>(instrument_name, timeframe, from_date, to_date, FixedScale());
+    }
+
+    std::vector<FixedCandle> get_historical_fixed_candles(const std::string& instrument_name,
+                                                          const std::string& timeframe,
+                                                          int64_t from_date,
+                                                          int64_t to_date,
+                                                          const FixedScale& scale) {
+        return fetch_candles<FixedCandle>(instrument_name, timeframe, from_date, to_date, scale);
+    }
+
+    // Row is Candle or FixedCandle: the payload is decoded straight into the requested representation.
+    template <typename Row>
+    std::vector<Row> fetch_candles(const std::string& instrument_name,
+                                   const std::string& timeframe,
+                                   int64_t from_date,
+                                   int64_t to_date,
+                                   const FixedScale& scale) {
+        std::vector<Row> candles;
+
+        std::string interval(kTimeframes.require(timeframe, "kraken").code);
 
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "kraken", "", "");
 
@@ -102,66 +126,31 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query_string}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsObject() && doc.HasMember("result") && doc["result"].IsObject()) {
-                                        const auto& result = doc["result"];
-                                        // Result keys are pair names, e.g. "XXBTZUSD". We iterate members.
-                                        for (auto itr = result.MemberBegin(); itr != result.MemberEnd(); ++itr) {
-                                            if (std::string(itr->name.GetString()) != "last" && itr->value.IsArray()) {
-                                                for (const auto& kline : itr->value.GetArray()) {
-                                                    if (kline.IsArray() && kline.Size() >= 6) {
-                                                        Candle candle;
-                                                        if (kline[0].IsInt64()) candle.timestamp = kline[0].GetInt64() * 1000;
-                                                        else if (kline[0].IsDouble()) candle.timestamp = (int64_t)(kline[0].GetDouble() * 1000);
-
-                                                        if (kline[1].IsString()) candle.open = std::stod(kline[1].GetString());
-                                                        else if (kline[1].IsDouble()) candle.open = kline[1].GetDouble();
-
-                                                        if (kline[2].IsString()) candle.high = std::stod(kline[2].GetString());
-                                                        else if (kline[2].IsDouble()) candle.high = kline[2].GetDouble();
-
-                                                        if (kline[3].IsString()) candle.low = std::stod(kline[3].GetString());
-                                                        else if (kline[3].IsDouble()) candle.low = kline[3].GetDouble();
-
-                                                        if (kline[4].IsString()) candle.close = std::stod(kline[4].GetString());
-                                                        else if (kline[4].IsDouble()) candle.close = kline[4].GetDouble();
-
-                                                        if (kline[6].IsString()) candle.volume = std::stod(kline[6].GetString());
-                                                        else if (kline[6].IsDouble()) candle.volume = kline[6].GetDouble();
-
-                                                        candles.push_back(candle);
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
+                                    decode_klines<kline_layouts::kKraken>(http_body(element), scale, candles);
                                 }
                             }
 
                             if (!candles.empty()) {
                                  if (from_date > 0 || to_date > 0) {
-                                     candles.erase(std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Candle& c) {
+                                     candles.erase(std::remove_if(candles.begin(), candles.end(), [from_date, to_date](const Row& c) {
                                          if (to_date > 0 && c.timestamp > to_date) return true;
                                          if (from_date > 0 && c.timestamp < from_date) return true;
                                          return false;
                                      }), candles.end());
                                  }
 
-                                std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+                                std::sort(candles.begin(), candles.end(), [](const Row& a, const Row& b) {
                                     return a.timestamp < b.timestamp;
                                 });
                                 return candles;
@@ -172,7 +161,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -195,4 +183,16 @@ std::vector<Candle> Kraken::get_historical_candles(const std::string& instrument
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+std::vector<FixedCandle> Kraken::get_historical_fixed_candles(const std::string& instrument_name,
+                                                              const std::string& timeframe,
+                                                              int64_t from_date,
+                                                              int64_t to_date,
+                                                              const FixedScale& scale) {
+    return pimpl->get_historical_fixed_candles(instrument_name, timeframe, from_date, to_date, scale);
+}
+
+TimeframeTable Kraken::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
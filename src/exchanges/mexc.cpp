@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/mexc.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -13,37 +17,54 @@
 
 namespace nccapi {
 
+namespace {
+    // Mexc interval
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "60m"},
+        {"4h"_tf, "4h"},
+        {"1d"_tf, "1d"},
+        {"1w"_tf, "1W"},
+        {"1M"_tf, "1M"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Mexc::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "mexc");
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                            catalog.reserve(message.getElementList().size());
                             for (const auto& element : message.getElementList()) {
-                                Instrument instrument;
+                                Instrument& instrument = catalog.emplace();
                                 instrument.id = element.getValue(CCAPI_INSTRUMENT);
                                 instrument.base = element.getValue(CCAPI_BASE_ASSET);
                                 instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
 
                                 std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
 
                                 std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
 
                                 std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
+                                if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
 
                                 if (!instrument.base.empty() && !instrument.quote.empty()) {
                                     instrument.symbol = instrument.base + "/" + instrument.quote;
@@ -52,22 +73,17 @@ public:
                                 }
                                 instrument.type = "spot";
 
-                                for (const auto& pair : element.getNameValueMap()) {
-                                    instrument.info[std::string(pair.first)] = pair.second;
-                                }
-
-                                instruments.push_back(instrument);
+                                catalog.assign_info(instrument, element.getNameValueMap());
                             }
-                            return instruments;
+                            return catalog.finish();
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -77,19 +93,9 @@ public:
         std::vector<Candle> candles;
 
         // Use GENERIC_PUBLIC_REQUEST for MEXC
-        ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "mexc", "", "GET_KLINES");
-
-        // Mexc intervals: 1m, 5m, 15m, 30m, 60m, 4h, 1d, 1M
-        std::string interval = "1m";
-        if (timeframe == "1m") interval = "1m";
-        else if (timeframe == "5m") interval = "5m";
-        else if (timeframe == "15m") interval = "15m";
-        else if (timeframe == "30m") interval = "30m";
-        else if (timeframe == "1h") interval = "60m";
-        else if (timeframe == "4h") interval = "4h";
-        else if (timeframe == "1d") interval = "1d";
-        else if (timeframe == "1M") interval = "1M";
-        else interval = "1m";
+        ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "mexc", "", "");
+
+        std::string interval(kTimeframes.require(timeframe, "mexc").code);
 
         std::string query_string = "symbol=" + instrument_name + "&interval=" + interval;
         if (from_date > 0) query_string += "&startTime=" + std::to_string(from_date);
@@ -102,44 +108,18 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query_string}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_str = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_str.c_str());
-
-                                    if (!doc.HasParseError() && doc.IsArray()) {
-                                        for (const auto& item : doc.GetArray()) {
-                                            // [1660124280000, "24250", "24250.01", "24244.66", "24245.01", "3.08", "74697.518", "1660124339999"]
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                if (item[0].IsInt64()) candle.timestamp = item[0].GetInt64();
-                                                else if (item[0].IsString()) candle.timestamp = std::stoll(item[0].GetString());
-
-                                                auto getVal = [](const rapidjson::Value& v) -> double {
-                                                    if (v.IsString()) return std::stod(v.GetString());
-                                                    if (v.IsDouble()) return v.GetDouble();
-                                                    return 0.0;
-                                                };
-
-                                                candle.open = getVal(item[1]);
-                                                candle.high = getVal(item[2]);
-                                                candle.low = getVal(item[3]);
-                                                candle.close = getVal(item[4]);
-                                                candle.volume = getVal(item[5]);
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
+                                    if (decode_klines<kline_layouts::kMexc>(http_body(element), candles)) {
                                         // Sort first
                                         std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
                                             return a.timestamp < b.timestamp;
@@ -156,8 +136,6 @@ public:
                                             }
                                         }
                                         return candles;
-                                    } else {
-                                        // std::cout << "[DEBUG] MEXC Parse Error or Not Array: " << json_str << std::endl;
                                     }
                                 }
                             }
@@ -171,7 +149,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -194,4 +171,8 @@ std::vector<Candle> Mexc::get_historical_candles(const std::string& instrument_n
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Mexc::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
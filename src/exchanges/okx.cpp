@@ -1,95 +1,129 @@
 #include "nccapi/exchanges/okx.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
+#include <array>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/ticker_decoder.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
+#include "ccapi_cpp/ccapi_macro.h"
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "60"},
+        {"3m"_tf, "180"},
+        {"5m"_tf, "300"},
+        {"15m"_tf, "900"},
+        {"30m"_tf, "1800"},
+        {"1h"_tf, "3600"},
+        {"2h"_tf, "7200"},
+        {"4h"_tf, "14400"},
+        {"6h"_tf, "21600"},
+        {"12h"_tf, "43200"},
+        {"1d"_tf, "86400"},
+        {"1w"_tf, "604800"},
+        {"1M"_tf, "2592000"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+
+    // GET /api/v5/market/tickers?instType=..: {"code": "0", "data": [{"instId": .., "last": .., "bidPx": .., "askPx": .., ..}]}
+    // vol24h is in base currency on SPOT but in contracts on derivatives, where volCcy24h is the base amount.
+    constexpr TickerLayout kSpotTickers = TickerLayout::objects({"data"}, {{"instId", "last", "bidPx", "askPx", "vol24h"}});
+    constexpr TickerLayout kDerivativeTickers = TickerLayout::objects({"data"}, {{"instId", "last", "bidPx", "askPx", "volCcy24h"}});
+
+    struct TickerType {
+        std::string_view inst_type;
+        std::string_view type; // Instrument::type
+        bool (*decode)(const std::string&, std::string_view, TickerTable&);
+    };
+    constexpr std::array<TickerType, 3> kTickerTypes = {{
+        {"SPOT", "spot", decode_tickers<kSpotTickers>},
+        {"SWAP", "swap", decode_tickers<kDerivativeTickers>},
+        {"FUTURES", "future", decode_tickers<kDerivativeTickers>},
+    }};
+}
+
 class Okx::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
-    std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+    std::vector<Instrument> get_instruments(std::vector<PartialFailure>& failures) {
+        CatalogBuilder catalog(session->infoMode());
         // OKX requires instType: SPOT, SWAP, FUTURES, OPTION
         std::vector<std::string> instTypes = {"SPOT", "SWAP", "FUTURES", "OPTION"};
 
+        std::vector<ccapi::Request> requests;
         for (const auto& instType : instTypes) {
             ccapi::Request request(ccapi::Request::Operation::GET_INSTRUMENTS, "okx");
             request.appendParam({{"instType", instType}});
+            requests.push_back(request);
+        }
 
-            session->sendRequest(request);
-
-            auto start = std::chrono::steady_clock::now();
-            bool received = false;
-            while (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
-                std::vector<ccapi::Event> events = session->getEventQueue().purge();
-                for (const auto& event : events) {
-                    if (event.getType() == ccapi::Event::Type::RESPONSE) {
-                        for (const auto& message : event.getMessageList()) {
-                            if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
-                                for (const auto& element : message.getElementList()) {
-                                    Instrument instrument;
-                                    instrument.id = element.getValue(CCAPI_INSTRUMENT);
-                                    instrument.base = element.getValue(CCAPI_BASE_ASSET);
-                                    instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
-
-                                    std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
-                                    if (!price_inc.empty()) { try { instrument.tick_size = std::stod(price_inc); } catch(...) {} }
-
-                                    std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
-                                    if (!qty_inc.empty()) { try { instrument.step_size = std::stod(qty_inc); } catch(...) {} }
-
-                                    std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
-                                    if (!qty_min.empty()) { try { instrument.min_size = std::stod(qty_min); } catch(...) {} }
-
-                                    if(element.has(CCAPI_CONTRACT_SIZE)) {
-                                         std::string val = element.getValue(CCAPI_CONTRACT_SIZE);
-                                         if(!val.empty()) { try { instrument.contract_size = std::stod(val); } catch(...) {} }
-                                    }
-
-                                    // Symbol construction logic
-                                    if (!instrument.base.empty() && !instrument.quote.empty()) {
-                                        instrument.symbol = instrument.base + "/" + instrument.quote;
-                                    } else {
-                                        instrument.symbol = instrument.id;
-                                    }
-
-                                    // Map OKX type
-                                    if (instType == "SPOT") instrument.type = "spot";
-                                    else if (instType == "SWAP") instrument.type = "swap"; // Perpetual Swap
-                                    else if (instType == "FUTURES") instrument.type = "future"; // Expiry Future
-                                    else if (instType == "OPTION") instrument.type = "option";
-
-                                    if (element.has(CCAPI_INSTRUMENT_STATUS)) {
-                                        instrument.active = (element.getValue(CCAPI_INSTRUMENT_STATUS) == "live");
-                                    }
-
-                                    for (const auto& pair : element.getNameValueMap()) {
-                                        instrument.info[std::string(pair.first)] = pair.second;
-                                    }
-
-                                    instruments.push_back(instrument);
-                                }
-                                received = true;
-                            } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                                // Log error or continue
-                            }
+        // All instTypes are fetched concurrently
+        auto result = session->fanOut(requests, std::chrono::seconds(5));
+
+        for (size_t i = 0; i < instTypes.size(); ++i) {
+            const auto& instType = instTypes[i];
+            for (const auto& message : result.messages[i]) {
+                if (message.getType() == ccapi::Message::Type::GET_INSTRUMENTS) {
+                    catalog.reserve(message.getElementList().size());
+                    for (const auto& element : message.getElementList()) {
+                        Instrument& instrument = catalog.emplace();
+                        instrument.id = element.getValue(CCAPI_INSTRUMENT);
+                        instrument.base = element.getValue(CCAPI_BASE_ASSET);
+                        instrument.quote = element.getValue(CCAPI_QUOTE_ASSET);
+
+                        std::string price_inc = element.getValue(CCAPI_ORDER_PRICE_INCREMENT);
+                        if (!parse_optional_decimal(price_inc, instrument.tick_size)) { catalog.discard(); continue; }
+
+                        std::string qty_inc = element.getValue(CCAPI_ORDER_QUANTITY_INCREMENT);
+                        if (!parse_optional_decimal(qty_inc, instrument.step_size)) { catalog.discard(); continue; }
+
+                        std::string qty_min = element.getValue(CCAPI_ORDER_QUANTITY_MIN);
+                        if (!parse_optional_decimal(qty_min, instrument.min_size)) { catalog.discard(); continue; }
+
+                        if(element.has(CCAPI_CONTRACT_SIZE)) {
+                             std::string val = element.getValue(CCAPI_CONTRACT_SIZE);
+                             if (!parse_optional_decimal(val, instrument.contract_size)) { catalog.discard(); continue; }
+                        }
+
+                        // Symbol construction logic
+                        if (!instrument.base.empty() && !instrument.quote.empty()) {
+                            instrument.symbol = instrument.base + "/" + instrument.quote;
+                        } else {
+                            instrument.symbol = instrument.id;
+                        }
+
+                        // Map OKX type
+                        if (instType == "SPOT") instrument.type = "spot";
+                        else if (instType == "SWAP") instrument.type = "swap"; // Perpetual Swap
+                        else if (instType == "FUTURES") instrument.type = "future"; // Expiry Future
+                        else if (instType == "OPTION") instrument.type = "option";
+
+                        if (element.has(CCAPI_INSTRUMENT_STATUS)) {
+                            instrument.active = (element.getValue(CCAPI_INSTRUMENT_STATUS) == "live");
                         }
+
+                        catalog.assign_info(instrument, element.getNameValueMap());
                     }
                 }
-                if (received) break;
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
         }
 
-        return instruments;
+        for (const auto& failure : result.failures) {
+            failures.push_back({"instType=" + instTypes[failure.index], failure.timedOut, failure.reason});
+        }
+
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -100,17 +134,17 @@ public:
         ccapi::Request request(ccapi::Request::Operation::GET_HISTORICAL_CANDLESTICKS, "okx", instrument_name);
 
         request.appendParam({
-            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::to_string(timeframeToSeconds(timeframe))},
+            {CCAPI_CANDLESTICK_INTERVAL_SECONDS, std::string(kTimeframes.require(timeframe, "okx").code)},
             {CCAPI_START_TIME_SECONDS, std::to_string(from_date / 1000)},
             {CCAPI_END_TIME_SECONDS, std::to_string(to_date / 1000)},
             {CCAPI_LIMIT, "100"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
@@ -122,11 +156,14 @@ public:
                                 candle.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
                                     message.getTime().time_since_epoch()).count();
 
-                                candle.open = std::stod(element.getValue(CCAPI_OPEN_PRICE));
-                                candle.high = std::stod(element.getValue(CCAPI_HIGH_PRICE));
-                                candle.low = std::stod(element.getValue(CCAPI_LOW_PRICE));
-                                candle.close = std::stod(element.getValue(CCAPI_CLOSE_PRICE));
-                                candle.volume = std::stod(element.getValue(CCAPI_VOLUME));
+                                // A malformed or missing field drops the row rather than zero-filling it.
+                                if (!parse_decimal(element.getValue(CCAPI_OPEN_PRICE), candle.open) ||
+                                    !parse_decimal(element.getValue(CCAPI_HIGH_PRICE), candle.high) ||
+                                    !parse_decimal(element.getValue(CCAPI_LOW_PRICE), candle.low) ||
+                                    !parse_decimal(element.getValue(CCAPI_CLOSE_PRICE), candle.close) ||
+                                    !parse_decimal(element.getValue(CCAPI_VOLUME), candle.volume)) {
+                                    continue;
+                                }
 
                                 candles.push_back(candle);
                             }
@@ -142,26 +179,46 @@ public:
                 });
                 return candles;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
 
-    int timeframeToSeconds(const std::string& timeframe) {
-        if (timeframe == "1m") return 60;
-        if (timeframe == "3m") return 180;
-        if (timeframe == "5m") return 300;
-        if (timeframe == "15m") return 900;
-        if (timeframe == "30m") return 1800;
-        if (timeframe == "1h") return 3600;
-        if (timeframe == "2h") return 7200;
-        if (timeframe == "4h") return 14400;
-        if (timeframe == "6h") return 21600;
-        if (timeframe == "12h") return 43200;
-        if (timeframe == "1d") return 86400;
-        if (timeframe == "1w") return 604800;
-        if (timeframe == "1M") return 2592000;
-        return 60;
+    TickerTable get_tickers(std::vector<PartialFailure>& failures) {
+        TickerTable tickers;
+        // One request per instType, all sent at once (OPTION is left out: thousands of strikes, rarely ranked by ticker)
+        std::vector<ccapi::Request> requests;
+        for (const auto& type : kTickerTypes) {
+            ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "okx", "", "");
+            request.appendParam({
+                {CCAPI_HTTP_METHOD, "GET"},
+                {CCAPI_HTTP_PATH, "/api/v5/market/tickers"},
+                {CCAPI_HTTP_QUERY_STRING, "instType=" + std::string(type.inst_type)}
+            });
+            requests.push_back(request);
+        }
+
+        auto result = session->fanOut(requests, std::chrono::seconds(15));
+
+        for (size_t i = 0; i < kTickerTypes.size(); ++i) {
+            const auto& type = kTickerTypes[i];
+            for (const auto& message : result.messages[i]) {
+                if (message.getType() != ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) continue;
+                for (const auto& element : message.getElementList()) {
+                    if (!element.has(CCAPI_HTTP_BODY)) continue;
+                    const size_t before = tickers.size();
+                    if (!type.decode(http_body(element), type.type, tickers)) {
+                        failures.push_back({"instType=" + std::string(type.inst_type), false, "unexpected ticker payload"});
+                        tickers.truncate(before);
+                    }
+                }
+            }
+        }
+
+        for (const auto& failure : result.failures) {
+            failures.push_back({"instType=" + std::string(kTickerTypes[failure.index].inst_type), failure.timedOut, failure.reason});
+        }
+
+        return tickers;
     }
 
 private:
@@ -172,7 +229,14 @@ Okx::Okx(std::shared_ptr<UnifiedSession> session) : pimpl(std::make_unique<Impl>
 Okx::~Okx() = default;
 
 std::vector<Instrument> Okx::get_instruments() {
-    return pimpl->get_instruments();
+    std::vector<PartialFailure> failures;
+    std::vector<Instrument> instruments = pimpl->get_instruments(failures);
+    warn_partial_failures(get_name(), failures);
+    return instruments;
+}
+
+std::vector<Instrument> Okx::get_instruments(std::vector<PartialFailure>& failures) {
+    return pimpl->get_instruments(failures);
 }
 
 std::vector<Candle> Okx::get_historical_candles(const std::string& instrument_name,
@@ -182,4 +246,19 @@ std::vector<Candle> Okx::get_historical_candles(const std::string& instrument_na
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TickerTable Okx::get_tickers() {
+    std::vector<PartialFailure> failures;
+    TickerTable tickers = pimpl->get_tickers(failures);
+    warn_partial_failures(get_name(), failures);
+    return tickers;
+}
+
+TickerTable Okx::get_tickers(std::vector<PartialFailure>& failures) {
+    return pimpl->get_tickers(failures);
+}
+
+TimeframeTable Okx::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -1,10 +1,14 @@
 #include "nccapi/exchanges/whitebit.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <algorithm>
 
+#include "nccapi/decimal.hpp"
+#include "nccapi/timeframe.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
 #include "nccapi/sessions/unified_session.hpp"
+#include "nccapi/sessions/json_body.hpp"
+#include "nccapi/sessions/kline_layouts.hpp"
 #include "ccapi_cpp/ccapi_request.h"
 #include "ccapi_cpp/ccapi_event.h"
 #include "ccapi_cpp/ccapi_message.h"
@@ -14,36 +18,56 @@
 
 namespace nccapi {
 
+namespace {
+    constexpr NativeTimeframe kNativeTimeframes[] = {
+        {"1m"_tf, "1m"},
+        {"3m"_tf, "3m"},
+        {"5m"_tf, "5m"},
+        {"15m"_tf, "15m"},
+        {"30m"_tf, "30m"},
+        {"1h"_tf, "1h"},
+        {"2h"_tf, "2h"},
+        {"4h"_tf, "4h"},
+        {"6h"_tf, "6h"},
+        {"8h"_tf, "8h"},
+        {"12h"_tf, "12h"},
+        {"1d"_tf, "1d"},
+        {"3d"_tf, "3d"},
+        {"1w"_tf, "1w"},
+        {"1M"_tf, "1M"},
+    };
+    constexpr TimeframeTable kTimeframes(kNativeTimeframes);
+}
+
 class Whitebit::Impl {
 public:
     Impl(std::shared_ptr<UnifiedSession> s) : session(s) {}
 
     std::vector<Instrument> get_instruments() {
-        std::vector<Instrument> instruments;
+        CatalogBuilder catalog(session->infoMode());
         ccapi::Request request(ccapi::Request::Operation::GENERIC_PUBLIC_REQUEST, "whitebit", "", "");
         request.appendParam({
             {CCAPI_HTTP_PATH, "/api/v4/public/markets"},
             {CCAPI_HTTP_METHOD, "GET"}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
+                                    const rapidjson::Document& doc = parse_http_body(element);
 
                                     if (!doc.HasParseError() && doc.IsArray()) {
+                                        catalog.reserve(doc.Size());
                                         for (const auto& item : doc.GetArray()) {
-                                            Instrument instrument;
+                                            Instrument& instrument = catalog.emplace();
                                             if (item.HasMember("name")) {
                                                 instrument.id = item["name"].GetString();
                                                 instrument.symbol = instrument.id; // Usually e.g. BTC_USDT
@@ -56,22 +80,19 @@ public:
                                                 }
                                             }
                                             instrument.type = "spot"; // WhiteBIT generic markets are spot
-
-                                            instruments.push_back(instrument);
                                         }
-                                        return instruments;
+                                        return catalog.finish();
                                     }
                                 }
                             }
                         } else if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR) {
-                            return instruments;
+                            return catalog.finish();
                         }
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        return instruments;
+        return catalog.finish();
     }
 
     std::vector<Candle> get_historical_candles(const std::string& instrument_name,
@@ -85,22 +106,7 @@ public:
         // V4: GET /api/v4/public/kline
         // Params: market, interval, limit, start, end
 
-        std::string interval = "1m";
-        if (timeframe == "1m") interval = "1m";
-        else if (timeframe == "3m") interval = "3m";
-        else if (timeframe == "5m") interval = "5m";
-        else if (timeframe == "15m") interval = "15m";
-        else if (timeframe == "30m") interval = "30m";
-        else if (timeframe == "1h") interval = "1h";
-        else if (timeframe == "2h") interval = "2h";
-        else if (timeframe == "4h") interval = "4h";
-        else if (timeframe == "6h") interval = "6h";
-        else if (timeframe == "8h") interval = "8h";
-        else if (timeframe == "12h") interval = "12h";
-        else if (timeframe == "1d") interval = "1d";
-        else if (timeframe == "3d") interval = "3d";
-        else if (timeframe == "1w") interval = "1w";
-        else if (timeframe == "1M") interval = "1M";
+        std::string interval(kTimeframes.require(timeframe, "whitebit").code);
 
         std::string query = "market=" + instrument_name + "&interval=" + interval + "&limit=1000";
         if (from_date > 0) query += "&start=" + std::to_string(from_date / 1000);
@@ -112,51 +118,20 @@ public:
             {CCAPI_HTTP_QUERY_STRING, query}
         });
 
-        session->sendRequest(request);
+        auto pending = session->sendRequest(request);
 
         auto start = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - start < std::chrono::seconds(15)) {
-            std::vector<ccapi::Event> events = session->getEventQueue().purge();
+            std::vector<ccapi::Event> events = pending.wait(start + std::chrono::seconds(15));
             for (const auto& event : events) {
                 if (event.getType() == ccapi::Event::Type::RESPONSE) {
                     for (const auto& message : event.getMessageList()) {
                         if (message.getType() == ccapi::Message::Type::GENERIC_PUBLIC_REQUEST) {
                             for (const auto& element : message.getElementList()) {
                                 if (element.has(CCAPI_HTTP_BODY)) {
-                                    std::string json_content = element.getValue(CCAPI_HTTP_BODY);
-                                    rapidjson::Document doc;
-                                    doc.Parse(json_content.c_str());
-
-                                    // WhiteBIT returns: { "result": [ [time, open, close, high, low, vol_base, vol_quote], ... ] }
-                                    // Wait, V4 might be different. Let's check V1 structure or V4.
-                                    // V4 Example: "result": [ [ 1594242960, "9246.06", "9246.06", "9246.06", "9246.06", "0", "0" ] ]
-                                    // But sometimes it's just array of array without "result" wrapper?
-                                    // The docs say: { "result": [...] } but some endpoints return [...]
-
-                                    const rapidjson::Value* rows = nullptr;
-                                    if (!doc.HasParseError()) {
-                                        if (doc.IsArray()) rows = &doc;
-                                        else if (doc.IsObject() && doc.HasMember("result") && doc["result"].IsArray()) rows = &doc["result"];
-                                        else if (doc.IsObject() && doc.HasMember("code")) {
-                                            // Error
-                                            std::cout << "WhiteBIT Error: " << json_content << std::endl;
-                                        }
-                                    }
-
-                                    if (rows) {
-                                        for (const auto& item : rows->GetArray()) {
-                                            if (item.IsArray() && item.Size() >= 6) {
-                                                Candle candle;
-                                                candle.timestamp = static_cast<uint64_t>(item[0].GetInt64()) * 1000;
-                                                candle.open = std::stod(item[1].GetString());
-                                                candle.close = std::stod(item[2].GetString()); // Open, Close
-                                                candle.high = std::stod(item[3].GetString());
-                                                candle.low = std::stod(item[4].GetString());
-                                                candle.volume = std::stod(item[5].GetString()); // Base vol
-
-                                                candles.push_back(candle);
-                                            }
-                                        }
+                                    const std::string& body = http_body(element);
+                                    if (!decode_klines<kline_layouts::kWhitebit>(body, candles) && !decode_klines<kline_layouts::kWhitebitBare>(body, candles)) {
+                                        std::cout << "WhiteBIT Error: " << body << std::endl;
                                     }
                                 }
                             }
@@ -179,7 +154,6 @@ public:
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         return candles;
     }
@@ -202,4 +176,8 @@ std::vector<Candle> Whitebit::get_historical_candles(const std::string& instrume
     return pimpl->get_historical_candles(instrument_name, timeframe, from_date, to_date);
 }
 
+TimeframeTable Whitebit::timeframes() const {
+    return kTimeframes;
+}
+
 } // namespace nccapi
@@ -0,0 +1,58 @@
+#include "nccapi/executor.hpp"
+
+namespace nccapi {
+
+Executor::Executor(size_t max_workers) : max_workers_(max_workers > 0 ? max_workers : 1) {}
+
+Executor::~Executor() {
+    std::deque<Task> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        pending.swap(tasks_);
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    // Never started: answer the callers instead of leaving them waiting forever.
+    for (auto& task : pending) {
+        if (task.cancel) task.cancel();
+    }
+}
+
+void Executor::post(std::function<void()> task, std::function<void()> cancel) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_) {
+            // Posted by a task still running during shutdown.
+            lock.unlock();
+            if (cancel) cancel();
+            return;
+        }
+        tasks_.push_back(Task{std::move(task), std::move(cancel)});
+        if (idle_ < tasks_.size() && workers_.size() < max_workers_) {
+            workers_.emplace_back([this] { run(); });
+        }
+    }
+    cv_.notify_one();
+}
+
+void Executor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        ++idle_;
+        cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        --idle_;
+        if (stopping_) return;
+
+        std::function<void()> task = std::move(tasks_.front().run);
+        tasks_.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+} // namespace nccapi
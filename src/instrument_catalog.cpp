@@ -0,0 +1,133 @@
+#include "nccapi/instrument_catalog.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace nccapi {
+
+namespace {
+    std::string upper(std::string_view text) {
+        std::string out(text);
+        for (auto& c : out) {
+            if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        }
+        return out;
+    }
+}
+
+InstrumentCatalog::InstrumentCatalog(std::vector<Instrument> instruments) : instruments_(std::move(instruments)) {
+    build();
+}
+
+InstrumentCatalog::InstrumentCatalog(const InstrumentCatalog& other) : instruments_(other.instruments_) {
+    // The indexes point into the copied strings: rebuild rather than copy them.
+    build();
+}
+
+InstrumentCatalog& InstrumentCatalog::operator=(const InstrumentCatalog& other) {
+    if (this != &other) {
+        instruments_ = other.instruments_;
+        build();
+    }
+    return *this;
+}
+
+void InstrumentCatalog::build() {
+    by_id_.clear();
+    by_symbol_.clear();
+    by_base_.clear();
+    by_quote_.clear();
+    by_type_.clear();
+    by_settle_.clear();
+    prefix_keys_.clear();
+
+    by_id_.reserve(instruments_.size());
+    by_symbol_.reserve(instruments_.size());
+    prefix_keys_.reserve(instruments_.size() * 2);
+    for (uint32_t i = 0; i < instruments_.size(); ++i) {
+        const Instrument& instrument = instruments_[i];
+        by_id_.emplace(instrument.id, i);
+        if (!instrument.symbol.empty()) by_symbol_.emplace(instrument.symbol, i);
+        if (!instrument.base.empty()) by_base_[instrument.base].push_back(i);
+        if (!instrument.quote.empty()) by_quote_[instrument.quote].push_back(i);
+        if (!instrument.type.empty()) by_type_[instrument.type].push_back(i);
+        if (!instrument.settle.empty()) by_settle_[instrument.settle].push_back(i);
+
+        prefix_keys_.emplace_back(upper(instrument.id), i);
+        if (instrument.symbol != instrument.id) prefix_keys_.emplace_back(upper(instrument.symbol), i);
+    }
+    std::sort(prefix_keys_.begin(), prefix_keys_.end());
+}
+
+const Instrument* InstrumentCatalog::find_by_id(std::string_view id) const {
+    auto it = by_id_.find(id);
+    return it == by_id_.end() ? nullptr : &instruments_[it->second];
+}
+
+const Instrument* InstrumentCatalog::find_by_symbol(std::string_view symbol) const {
+    auto it = by_symbol_.find(symbol);
+    return it == by_symbol_.end() ? nullptr : &instruments_[it->second];
+}
+
+const Instrument* InstrumentCatalog::find(std::string_view id_or_symbol) const {
+    const Instrument* instrument = find_by_id(id_or_symbol);
+    return instrument ? instrument : find_by_symbol(id_or_symbol);
+}
+
+std::vector<const Instrument*> InstrumentCatalog::lookup(const Index& index, std::string_view key) const {
+    std::vector<const Instrument*> result;
+    auto it = index.find(key);
+    if (it == index.end()) return result;
+    result.reserve(it->second.size());
+    for (uint32_t i : it->second) result.push_back(&instruments_[i]);
+    return result;
+}
+
+std::vector<const Instrument*> InstrumentCatalog::select(std::string_view base,
+                                                         std::string_view quote,
+                                                         std::string_view type,
+                                                         std::string_view settle) const {
+    std::vector<const Instrument*> result;
+    const std::vector<uint32_t>* smallest = nullptr;
+    const std::pair<const Index*, std::string_view> filters[] = {
+        {&by_base_, base}, {&by_quote_, quote}, {&by_type_, type}, {&by_settle_, settle}
+    };
+    for (const auto& filter : filters) {
+        if (filter.second.empty()) continue;
+        auto it = filter.first->find(filter.second);
+        if (it == filter.first->end()) return result;
+        if (!smallest || it->second.size() < smallest->size()) smallest = &it->second;
+    }
+
+    if (!smallest) {
+        result.reserve(instruments_.size());
+        for (const auto& instrument : instruments_) result.push_back(&instrument);
+        return result;
+    }
+    for (uint32_t i : *smallest) {
+        const Instrument& instrument = instruments_[i];
+        if (!base.empty() && instrument.base != base) continue;
+        if (!quote.empty() && instrument.quote != quote) continue;
+        if (!type.empty() && instrument.type != type) continue;
+        if (!settle.empty() && instrument.settle != settle) continue;
+        result.push_back(&instrument);
+    }
+    return result;
+}
+
+std::vector<const Instrument*> InstrumentCatalog::with_prefix(std::string_view prefix, size_t limit) const {
+    std::vector<const Instrument*> result;
+    const std::string key = upper(prefix);
+    auto it = std::lower_bound(prefix_keys_.begin(), prefix_keys_.end(), key,
+                               [](const std::pair<std::string, uint32_t>& entry, const std::string& k) {
+                                   return entry.first < k;
+                               });
+    std::unordered_set<uint32_t> seen; // An instrument can match on both its id and its symbol
+    for (; it != prefix_keys_.end() && it->first.compare(0, key.size(), key) == 0; ++it) {
+        if (!seen.insert(it->second).second) continue;
+        result.push_back(&instruments_[it->second]);
+        if (limit != 0 && result.size() >= limit) break;
+    }
+    return result;
+}
+
+} // namespace nccapi
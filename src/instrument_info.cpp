@@ -0,0 +1,95 @@
+#include "nccapi/instrument_info.hpp"
+#include <cstdint>
+#include <mutex>
+
+namespace nccapi {
+
+namespace {
+    // Decoding is rare and short: a few striped locks instead of a mutex per instrument.
+    std::mutex& decode_mutex(const void* info) {
+        static std::mutex mutexes[32];
+        return mutexes[(reinterpret_cast<uintptr_t>(info) / sizeof(void*)) % 32];
+    }
+}
+
+InstrumentInfo::InstrumentInfo(const InstrumentInfo& other) {
+    *this = other;
+}
+
+InstrumentInfo::InstrumentInfo(InstrumentInfo&& other) noexcept {
+    *this = std::move(other);
+}
+
+InstrumentInfo& InstrumentInfo::operator=(const InstrumentInfo& other) {
+    if (this == &other) return *this;
+    if (other.decoded()) {
+        map_ = other.map_;
+        arena_.reset();
+        first_ = count_ = 0;
+        decoded_.store(true, std::memory_order_release);
+    } else {
+        // Still raw: share the arena, decode independently later.
+        map_.clear();
+        arena_ = other.arena_;
+        first_ = other.first_;
+        count_ = other.count_;
+        decoded_.store(false, std::memory_order_release);
+    }
+    return *this;
+}
+
+InstrumentInfo& InstrumentInfo::operator=(InstrumentInfo&& other) noexcept {
+    if (this == &other) return *this;
+    bool raw = !other.decoded();
+    map_ = std::move(other.map_);
+    arena_ = std::move(other.arena_);
+    first_ = other.first_;
+    count_ = other.count_;
+    decoded_.store(!raw, std::memory_order_release);
+    other.map_.clear();
+    other.first_ = other.count_ = 0;
+    other.decoded_.store(true, std::memory_order_release);
+    return *this;
+}
+
+size_t InstrumentInfo::size() const {
+    return decoded() ? map_.size() : count_;
+}
+
+void InstrumentInfo::clear() {
+    map_.clear();
+    arena_.reset();
+    first_ = count_ = 0;
+    decoded_.store(true, std::memory_order_release);
+}
+
+InstrumentInfo::Map& InstrumentInfo::map() {
+    if (!decoded()) decode();
+    return map_;
+}
+
+const InstrumentInfo::Map& InstrumentInfo::map() const {
+    if (!decoded()) decode();
+    return map_;
+}
+
+void InstrumentInfo::assign_raw(std::shared_ptr<const InfoArena> arena, uint32_t first, uint32_t count) {
+    map_.clear();
+    arena_ = std::move(arena);
+    first_ = first;
+    count_ = count;
+    decoded_.store(arena_ == nullptr, std::memory_order_release);
+}
+
+void InstrumentInfo::decode() const {
+    std::lock_guard<std::mutex> lock(decode_mutex(this));
+    if (decoded()) return;
+    Map decoded_map;
+    for_each([&decoded_map](std::string_view key, std::string_view value) {
+        decoded_map.emplace(std::string(key), std::string(value));
+    });
+    map_ = std::move(decoded_map);
+    decoded_.store(true, std::memory_order_release);
+}
+
+} // namespace nccapi
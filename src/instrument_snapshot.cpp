@@ -0,0 +1,147 @@
+#include "nccapi/instrument_snapshot.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace nccapi {
+
+namespace {
+    const char kMagic[4] = {'N', 'C', 'I', '1'};
+
+    class Writer {
+    public:
+        explicit Writer(std::ofstream& out) : out(out) {}
+
+        template <typename T>
+        void value(const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+        void string(std::string_view s) {
+            value(static_cast<uint32_t>(s.size()));
+            out.write(s.data(), s.size());
+        }
+
+    private:
+        std::ofstream& out;
+    };
+
+    class Reader {
+    public:
+        explicit Reader(std::ifstream& in) : in(in) {}
+
+        template <typename T>
+        bool value(T& v) { return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T))); }
+
+        bool string(std::string& s) {
+            uint32_t size = 0;
+            if (!value(size)) return false;
+            s.resize(size);
+            return size == 0 || static_cast<bool>(in.read(&s[0], size));
+        }
+
+    private:
+        std::ifstream& in;
+    };
+
+    void write_instrument(Writer& w, const Instrument& i) {
+        w.string(i.id);
+        w.string(i.symbol);
+        w.string(i.base);
+        w.string(i.quote);
+        w.string(i.settle);
+        w.string(i.type);
+        w.value(static_cast<uint8_t>(i.active ? 1 : 0));
+        w.value(i.tick_size);
+        w.value(i.step_size);
+        w.value(i.min_size);
+        w.value(i.min_notional);
+        w.value(i.contract_multiplier);
+        w.value(i.contract_size);
+        w.string(i.underlying);
+        w.string(i.expiry);
+        w.value(i.strike_price);
+        w.string(i.option_type);
+        w.value(i.maker_fee);
+        w.value(i.taker_fee);
+        // for_each: a lazy info is written from its arena without being decoded.
+        w.value(static_cast<uint32_t>(i.info.size()));
+        i.info.for_each([&w](std::string_view key, std::string_view value) {
+            w.string(key);
+            w.string(value);
+        });
+    }
+
+    bool read_instrument(Reader& r, Instrument& i, InfoCollector& info) {
+        uint8_t active = 0;
+        uint32_t info_count = 0;
+        bool ok = r.string(i.id) && r.string(i.symbol) && r.string(i.base) && r.string(i.quote) &&
+                  r.string(i.settle) && r.string(i.type) && r.value(active) &&
+                  r.value(i.tick_size) && r.value(i.step_size) && r.value(i.min_size) && r.value(i.min_notional) &&
+                  r.value(i.contract_multiplier) && r.value(i.contract_size) &&
+                  r.string(i.underlying) && r.string(i.expiry) && r.value(i.strike_price) && r.string(i.option_type) &&
+                  r.value(i.maker_fee) && r.value(i.taker_fee) && r.value(info_count);
+        if (!ok) return false;
+        i.active = active != 0;
+        std::vector<std::pair<std::string, std::string>> fields;
+        fields.reserve(std::min<uint32_t>(info_count, 256));
+        for (uint32_t n = 0; n < info_count; ++n) {
+            std::string key, value;
+            if (!r.string(key) || !r.string(value)) return false;
+            fields.emplace_back(std::move(key), std::move(value));
+        }
+        info.assign(i.info, fields);
+        return true;
+    }
+}
+
+bool write_instrument_snapshot(const std::string& path, const InstrumentSnapshot& snapshot) {
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        Writer w(out);
+        out.write(kMagic, sizeof(kMagic));
+        w.value(snapshot.fetched_at);
+        w.value(static_cast<uint64_t>(snapshot.instruments.size()));
+        for (const auto& instrument : snapshot.instruments) {
+            write_instrument(w, instrument);
+        }
+        if (!out) {
+            out.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool read_instrument_snapshot(const std::string& path, InstrumentSnapshot& snapshot, InfoMode info_mode) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(magic)) != 0) return false;
+
+    Reader r(in);
+    InstrumentSnapshot result;
+    uint64_t count = 0;
+    if (!r.value(result.fetched_at) || !r.value(count)) return false;
+
+    // Grow as we go rather than trusting `count` for the allocation: a corrupt header must not OOM.
+    InfoCollector info(info_mode);
+    for (uint64_t n = 0; n < count; ++n) {
+        Instrument instrument;
+        if (!read_instrument(r, instrument, info)) return false;
+        result.instruments.push_back(std::move(instrument));
+    }
+
+    snapshot = std::move(result);
+    return true;
+}
+
+} // namespace nccapi
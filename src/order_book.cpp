@@ -0,0 +1,90 @@
+#include "nccapi/order_book.hpp"
+#include <algorithm>
+
+namespace nccapi {
+
+namespace {
+    // Levels pushed beyond max_depth are trimmed in batches, not on every insertion.
+    constexpr size_t kTrimSlack = 2;
+}
+
+OrderBook::OrderBook(double tick_size, size_t max_depth)
+    : tick_size_(tick_size > 0 ? tick_size : 1e-8), max_depth_(max_depth) {
+    ticks_per_unit_ = 1.0 / tick_size_;
+    // Decimal ticks (0.01, 1e-8) have an integral inverse: keep it exact.
+    const double rounded = std::round(ticks_per_unit_);
+    if (rounded > 0 && std::fabs(ticks_per_unit_ - rounded) < 1e-6 * rounded) ticks_per_unit_ = rounded;
+    if (max_depth_ > 0) {
+        bids_.keys.reserve(max_depth_ * kTrimSlack);
+        bids_.quantities.reserve(max_depth_ * kTrimSlack);
+        asks_.keys.reserve(max_depth_ * kTrimSlack);
+        asks_.quantities.reserve(max_depth_ * kTrimSlack);
+    }
+}
+
+void OrderBook::set_ticks(Side side, int64_t ticks, double quantity) {
+    if (side == Side::Bid) set_key(bids_, ticks, quantity);
+    else set_key(asks_, -ticks, quantity);
+}
+
+void OrderBook::clear() {
+    bids_.keys.clear();
+    bids_.quantities.clear();
+    asks_.keys.clear();
+    asks_.quantities.clear();
+    timestamp_ = 0;
+}
+
+void OrderBook::set_key(BookSide& side, int64_t key, double quantity) {
+    auto& keys = side.keys;
+    auto& quantities = side.quantities;
+    const size_t n = keys.size();
+
+    // Direct index: in a book with a level at every tick, `key` sits (best - key) slots below the top.
+    size_t index = n;
+    if (n > 0 && key <= keys.back()) {
+        const uint64_t distance = static_cast<uint64_t>(keys.back()) - static_cast<uint64_t>(key);
+        if (distance < n && keys[n - 1 - distance] == key) {
+            index = n - 1 - distance;
+        } else {
+            index = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        }
+    }
+
+    const bool found = index < n && keys[index] == key;
+    if (quantity <= 0) {
+        if (found) {
+            keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(index));
+            quantities.erase(quantities.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+        return;
+    }
+    if (found) {
+        quantities[index] = quantity;
+        return;
+    }
+    keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(index), key);
+    quantities.insert(quantities.begin() + static_cast<std::ptrdiff_t>(index), quantity);
+
+    if (max_depth_ > 0 && keys.size() >= max_depth_ * kTrimSlack) {
+        // Drop the worst levels, which sit at the front.
+        const auto excess = static_cast<std::ptrdiff_t>(keys.size() - max_depth_);
+        keys.erase(keys.begin(), keys.begin() + excess);
+        quantities.erase(quantities.begin(), quantities.begin() + excess);
+    }
+}
+
+OrderBook::Levels OrderBook::view(const BookSide& side, int64_t sign, size_t depth) const {
+    Levels levels;
+    levels.book_ = this;
+    levels.sign_ = sign;
+    levels.count_ = std::min(depth, max_depth_ > 0 ? std::min(max_depth_, side.keys.size()) : side.keys.size());
+    if (!side.keys.empty()) {
+        levels.keys_ = side.keys.data();
+        levels.quantities_ = side.quantities.data();
+        levels.last_ = side.keys.size() - 1;
+    }
+    return levels;
+}
+
+} // namespace nccapi
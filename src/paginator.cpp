@@ -0,0 +1,243 @@
+#include "nccapi/paginator.hpp"
+#include "nccapi/executor.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace nccapi {
+
+int64_t timeframe_to_ms(const std::string& timeframe) {
+    Timeframe parsed;
+    return Timeframe::parse(timeframe, parsed) ? parsed.ms() : 0;
+}
+
+namespace {
+
+// Appends pages to `out` in ascending timestamp order, dropping duplicates and candles
+// outside [from_date, to_date] (no bound when 0). Pages cover disjoint, increasing
+// ranges and arrive in order, so sorting each page is enough.
+template <typename Row, typename Output>
+struct Stitcher {
+    Output& out;
+    int64_t from_date;
+    int64_t to_date;
+    bool has_last = false;
+    uint64_t last = 0;
+
+    void append(std::vector<Row>& page) {
+        std::sort(page.begin(), page.end(), [](const Row& a, const Row& b) {
+            return a.timestamp < b.timestamp;
+        });
+        for (const auto& candle : page) {
+            int64_t ts = static_cast<int64_t>(candle.timestamp);
+            if (from_date > 0 && ts < from_date) continue;
+            if (to_date > 0 && ts > to_date) continue;
+            if (has_last && candle.timestamp <= last) continue;
+            out.push_back(candle);
+            last = candle.timestamp;
+            has_last = true;
+        }
+    }
+};
+
+// Pages of one paginated call. Shared with the helpers posted to the executor: a helper
+// that only starts once every page has been taken must still find it alive.
+template <typename Row>
+struct PageJob {
+    std::vector<std::pair<int64_t, int64_t>> pages;
+    std::vector<std::vector<Row>> results; // Fetched pages waiting for an earlier one
+    std::vector<char> fetched;
+    std::function<std::vector<Row>(int64_t, int64_t)> fetch; // Only called while the caller waits
+    std::function<void(std::vector<Row>&)> stitch;            // Likewise
+    std::mutex mutex;
+    std::condition_variable idle;     // A helper finished
+    std::condition_variable progress; // A page was stitched, or an error was set
+    size_t window = 1;      // Pages taken but not stitched yet, at most
+    size_t next = 0;        // First page not taken yet
+    size_t stitched = 0;    // First page not stitched yet
+    bool stitching = false; // A thread is appending pages to the output
+    size_t active = 0;      // Helpers fetching a page
+    std::exception_ptr error;
+
+    // Fetch pages until none is left. Taking a page and registering as active happen
+    // under one lock, so once the caller sees no active helper none can start another.
+    // A thread only waits for the window while the pages before it are being fetched
+    // by threads that have started, so it never waits for a helper still queued.
+    void work(bool helper) {
+        while (true) {
+            size_t index = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                progress.wait(lock, [this] { return error || next >= pages.size() || next < stitched + window; });
+                if (error || next >= pages.size()) return;
+                index = next++;
+                if (helper) ++active;
+            }
+            try {
+                complete(index, fetch(pages[index].first, pages[index].second));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+                progress.notify_all();
+            }
+            if (helper) {
+                std::lock_guard<std::mutex> lock(mutex);
+                --active;
+                idle.notify_all();
+            }
+        }
+    }
+
+    // Store a fetched page, then append every page that is now contiguous with the
+    // output, in order and freeing each, unless another thread is already doing it.
+    void complete(size_t index, std::vector<Row> rows) {
+        std::unique_lock<std::mutex> lock(mutex);
+        results[index] = std::move(rows);
+        fetched[index] = 1;
+        if (stitching) return;
+        stitching = true;
+        while (!error && stitched < pages.size() && fetched[stitched]) {
+            std::vector<Row> page = std::move(results[stitched]);
+            lock.unlock();
+            try {
+                stitch(page);
+            } catch (...) {
+                lock.lock();
+                stitching = false;
+                throw;
+            }
+            std::vector<Row>().swap(page);
+            lock.lock();
+            ++stitched;
+            progress.notify_all();
+        }
+        stitching = false;
+    }
+};
+
+// Fetches [from_date, to_date] as consecutive pages and appends them to `out` in time
+// order. A single page is fetched when the exchange cannot paginate or the range fits
+// in one request; it is only sorted and deduplicated, as the exchange chose its range.
+// `fetch(from, to)` requests one page: Row is Candle or FixedCandle.
+// The calling thread fetches pages itself and up to max_in_flight - 1 helpers on the
+// executor join in; it never waits for a helper that has not started, so a call made
+// from a task running on the same executor cannot deadlock it. At most max_in_flight
+// pages are alive at a time, fetching or waiting for an earlier page.
+template <typename Row, typename Fetch, typename Output>
+void fetch_pages(Exchange& exchange,
+                 const std::string& timeframe,
+                 int64_t from_date,
+                 int64_t to_date,
+                 Executor& executor,
+                 size_t max_in_flight,
+                 Fetch fetch,
+                 Output& out) {
+    const int64_t tf_ms = timeframe_to_ms(timeframe);
+    const size_t page_size = exchange.max_candles_per_request();
+    Stitcher<Row, Output> single{out, 0, 0};
+    if (tf_ms <= 0 || page_size == 0 || from_date <= 0 || to_date <= from_date) {
+        std::vector<Row> page = fetch(from_date, to_date);
+        out.reserve(page.size());
+        single.append(page);
+        return;
+    }
+
+    // Page k covers [from + k*span, from + (k+1)*span - 1]: exactly page_size candle
+    // open times, so neither "end inclusive" nor "end exclusive" exchanges drop one.
+    const int64_t span = tf_ms * static_cast<int64_t>(page_size);
+    auto job = std::make_shared<PageJob<Row>>();
+    for (int64_t page_from = from_date; page_from <= to_date; page_from += span) {
+        job->pages.emplace_back(page_from, std::min(page_from + span - 1, to_date));
+    }
+    if (job->pages.size() == 1) {
+        std::vector<Row> page = fetch(from_date, to_date);
+        out.reserve(page.size());
+        single.append(page);
+        return;
+    }
+
+    // Room for one row per candle open time in the range: the series never regrows.
+    out.reserve(static_cast<size_t>((to_date - from_date) / tf_ms + 1));
+    Stitcher<Row, Output> stitcher{out, from_date, to_date};
+    job->results.resize(job->pages.size());
+    job->fetched.resize(job->pages.size(), 0);
+    job->fetch = fetch;
+    job->stitch = [&stitcher](std::vector<Row>& page) { stitcher.append(page); };
+    job->window = std::max<size_t>(max_in_flight, 1);
+
+    // Helpers run on the executor's persistent workers, whose per-thread JSON arenas and
+    // kline readers stay warm from one page (and one call) to the next.
+    size_t helpers = std::min(job->window, job->pages.size()) - 1;
+    for (size_t i = 0; i < helpers; ++i) {
+        executor.post([job]() { job->work(true); });
+    }
+    job->work(false);
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->idle.wait(lock, [&job] { return job->active == 0; });
+        // Late helpers may hold the job after this call returns: take the error out of
+        // it, and drop the references to this frame.
+        error.swap(job->error);
+        job->next = job->pages.size();
+        job->fetch = nullptr;
+        job->stitch = nullptr;
+        std::vector<std::vector<Row>>().swap(job->results);
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace
+
+std::vector<Candle> fetch_candles_paginated(Exchange& exchange,
+                                            const std::string& instrument_name,
+                                            const std::string& timeframe,
+                                            int64_t from_date,
+                                            int64_t to_date,
+                                            Executor& executor,
+                                            size_t max_in_flight) {
+    std::vector<Candle> candles;
+    fetch_pages<Candle>(exchange, timeframe, from_date, to_date, executor, max_in_flight,
+                        [&](int64_t from, int64_t to) {
+        return exchange.get_historical_candles(instrument_name, timeframe, from, to);
+    }, candles);
+    return candles;
+}
+
+CandleSeries fetch_candle_series_paginated(Exchange& exchange,
+                                           const std::string& instrument_name,
+                                           const std::string& timeframe,
+                                           int64_t from_date,
+                                           int64_t to_date,
+                                           Executor& executor,
+                                           size_t max_in_flight) {
+    CandleSeries series;
+    fetch_pages<Candle>(exchange, timeframe, from_date, to_date, executor, max_in_flight,
+                        [&](int64_t from, int64_t to) {
+        return exchange.get_historical_candles(instrument_name, timeframe, from, to);
+    }, series);
+    return series;
+}
+
+FixedCandleSeries fetch_fixed_series_paginated(Exchange& exchange,
+                                               const std::string& instrument_name,
+                                               const std::string& timeframe,
+                                               int64_t from_date,
+                                               int64_t to_date,
+                                               const FixedScale& scale,
+                                               Executor& executor,
+                                               size_t max_in_flight) {
+    FixedCandleSeries series(scale);
+    fetch_pages<FixedCandle>(exchange, timeframe, from_date, to_date, executor, max_in_flight,
+                             [&](int64_t from, int64_t to) {
+        return exchange.get_historical_fixed_candles(instrument_name, timeframe, from, to, scale);
+    }, series);
+    return series;
+}
+
+} // namespace nccapi
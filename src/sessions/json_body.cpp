@@ -0,0 +1,67 @@
+#include "nccapi/sessions/json_body.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "ccapi_cpp/ccapi_macro.h"
+
+namespace nccapi {
+
+namespace {
+    // Everything a thread needs to decode responses without going back to the heap.
+    struct JsonArena {
+        std::string text;                // In-situ copy of the body (capacity is kept)
+        std::vector<char> pool_buffer;   // User buffer backing the pool's first chunk
+        std::unique_ptr<rapidjson::MemoryPoolAllocator<>> pool;
+        std::unique_ptr<rapidjson::Document> document;
+    };
+
+    JsonArena& thread_arena() {
+        thread_local JsonArena arena;
+        return arena;
+    }
+
+    const size_t kInitialPoolSize = 64 * 1024;
+}
+
+const rapidjson::Document& parse_json_body(const std::string& body) {
+    JsonArena& arena = thread_arena();
+
+    if (arena.document) {
+        // Values live in the pool: dropping them frees nothing, rewinding the pool reclaims them.
+        arena.document->SetNull();
+    }
+
+    // The last payload overflowed the user buffer into heap chunks: size the buffer so it fits next time.
+    if (arena.pool && arena.pool->Capacity() > arena.pool_buffer.size()) {
+        size_t size = arena.pool_buffer.size();
+        while (size < arena.pool->Capacity()) size *= 2;
+        arena.document.reset();
+        arena.pool.reset();
+        arena.pool_buffer.resize(size);
+    }
+    if (!arena.pool) {
+        if (arena.pool_buffer.empty()) arena.pool_buffer.resize(kInitialPoolSize);
+        arena.pool = std::make_unique<rapidjson::MemoryPoolAllocator<>>(arena.pool_buffer.data(), arena.pool_buffer.size());
+        arena.document = std::make_unique<rapidjson::Document>(arena.pool.get());
+    } else {
+        arena.pool->Clear();
+    }
+
+    arena.text.assign(body);
+    arena.document->ParseInsitu(&arena.text[0]);
+    return *arena.document;
+}
+
+const std::string& http_body(const ccapi::Element& element) {
+    static const std::string empty;
+    const auto& values = element.getNameValueMap();
+    auto it = values.find(CCAPI_HTTP_BODY);
+    return it != values.end() ? it->second : empty;
+}
+
+const rapidjson::Document& parse_http_body(const ccapi::Element& element) {
+    return parse_json_body(http_body(element));
+}
+
+} // namespace nccapi
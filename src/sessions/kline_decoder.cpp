@@ -0,0 +1,11 @@
+#include "nccapi/sessions/kline_decoder.hpp"
+
+namespace nccapi {
+
+// One reader per thread, shared by all layouts.
+rapidjson::Reader& kline_reader() {
+    thread_local rapidjson::Reader reader;
+    return reader;
+}
+
+} // namespace nccapi
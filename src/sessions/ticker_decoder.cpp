@@ -0,0 +1,11 @@
+#include "nccapi/sessions/ticker_decoder.hpp"
+
+namespace nccapi {
+
+// One reader per thread, shared by all layouts.
+rapidjson::Reader& ticker_reader() {
+    thread_local rapidjson::Reader reader;
+    return reader;
+}
+
+} // namespace nccapi
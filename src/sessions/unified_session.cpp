@@ -38,29 +38,494 @@
 
 #include "ccapi_cpp/ccapi_session.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace nccapi {
 
-UnifiedSession::UnifiedSession(const ccapi::SessionOptions& options, const ccapi::SessionConfigs& configs, ccapi::EventHandler* eventHandler) {
-    session = new ccapi::Session(options, configs, eventHandler);
+// Correlation-ID router: one mailbox per in-flight request.
+// Installed as the ccapi::EventHandler of the shared session, so events are
+// pushed to the waiting request the moment ccapi dispatches them.
+class UnifiedSession::Router : public ccapi::EventHandler {
+public:
+    explicit Router(ccapi::EventHandler* fallback) : fallback(fallback) {}
+
+    std::string open() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string correlationId = "nccapi-" + std::to_string(++nextId);
+        mailboxes[correlationId] = std::make_shared<Mailbox>();
+        return correlationId;
+    }
+
+    void close(const std::string& correlationId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        mailboxes.erase(correlationId);
+    }
+
+    bool isOpen(const std::string& correlationId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return mailboxes.count(correlationId) > 0;
+    }
+
+    // Time a request spends in the rate-limit queue does not count against its caller's deadline.
+    void markQueued(const std::string& correlationId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = mailboxes.find(correlationId);
+        if (it == mailboxes.end()) return;
+        it->second->queued = true;
+        it->second->queuedAt = std::chrono::steady_clock::now();
+    }
+
+    void markDispatched(const std::string& correlationId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = mailboxes.find(correlationId);
+        if (it == mailboxes.end() || !it->second->queued) return;
+        it->second->queued = false;
+        it->second->queueDelay += std::chrono::steady_clock::now() - it->second->queuedAt;
+        it->second->ready.notify_one();
+    }
+
+    std::vector<ccapi::Event> wait(const std::string& correlationId, std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = mailboxes.find(correlationId);
+        if (it == mailboxes.end()) return {};
+
+        std::shared_ptr<Mailbox> mailbox = it->second;
+        while (mailbox->events.empty()) {
+            if (mailbox->queued) {
+                mailbox->ready.wait(lock);
+            } else if (mailbox->ready.wait_until(lock, deadline + mailbox->queueDelay) == std::cv_status::timeout) {
+                break;
+            }
+        }
+
+        std::vector<ccapi::Event> events;
+        events.swap(mailbox->events);
+        return events;
+    }
+
+    // Market data: one stream per distinct subscription, shared by its listeners.
+    // Sets `isNew` when the caller has to send the ccapi subscription.
+    std::string attach(const std::string& key, StreamListener listener, uint64_t& listenerId, bool& isNew) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string& correlationId = streamIds[key];
+        isNew = correlationId.empty();
+        if (isNew) {
+            correlationId = "nccapi-stream-" + std::to_string(++nextId);
+            streams[correlationId] = std::make_shared<const Listeners>();
+        }
+        // Copy on write: processEvent calls listeners on a snapshot, outside the lock.
+        std::shared_ptr<const Listeners>& listeners = streams[correlationId];
+        auto updated = std::make_shared<Listeners>(*listeners);
+        listenerId = ++nextListenerId;
+        updated->emplace_back(listenerId, std::move(listener));
+        listeners = std::move(updated);
+        return correlationId;
+    }
+
+    void detach(const std::string& correlationId, uint64_t listenerId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = streams.find(correlationId);
+        if (it == streams.end()) return;
+        auto updated = std::make_shared<Listeners>();
+        for (const auto& entry : *it->second) {
+            if (entry.first != listenerId) updated->push_back(entry);
+        }
+        it->second = std::move(updated);
+    }
+
+    void processEvent(const ccapi::Event& event, ccapi::Session* sessionPtr) override {
+        bool routed = false;
+        std::vector<std::pair<std::shared_ptr<const Listeners>, const ccapi::Message*>> deliveries;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::unordered_set<std::string> targets;
+            for (const auto& message : event.getMessageList()) {
+                for (const auto& correlationId : message.getCorrelationIdList()) {
+                    if (mailboxes.count(correlationId)) {
+                        targets.insert(correlationId);
+                    } else {
+                        auto stream = streams.find(correlationId);
+                        if (stream == streams.end()) continue;
+                        deliveries.emplace_back(stream->second, &message);
+                        // A rejected stream is not shared any more: the next identical subscription retries.
+                        if (message.getType() == ccapi::Message::Type::SUBSCRIPTION_FAILURE) forgetStream(correlationId);
+                    }
+                }
+            }
+            for (const auto& correlationId : targets) {
+                auto& mailbox = mailboxes[correlationId];
+                mailbox->events.push_back(event);
+                mailbox->ready.notify_one();
+            }
+            routed = !targets.empty() || !deliveries.empty();
+        }
+        for (const auto& delivery : deliveries) {
+            for (const auto& entry : *delivery.first) entry.second(*delivery.second);
+        }
+        // Events nobody is waiting for (session status, late responses to timed-out
+        // requests) go to the user-supplied handler, if any, and are dropped otherwise.
+        if (!routed && fallback) {
+            fallback->processEvent(event, sessionPtr);
+        }
+    }
+
+private:
+    void forgetStream(const std::string& correlationId) {
+        for (auto it = streamIds.begin(); it != streamIds.end(); ++it) {
+            if (it->second == correlationId) {
+                streamIds.erase(it);
+                return;
+            }
+        }
+    }
+
+    struct Mailbox {
+        std::vector<ccapi::Event> events;
+        std::condition_variable ready;
+        bool queued = false;
+        std::chrono::steady_clock::time_point queuedAt;
+        std::chrono::steady_clock::duration queueDelay{0};
+    };
+
+    using Listeners = std::vector<std::pair<uint64_t, StreamListener>>;
+
+    ccapi::EventHandler* fallback;
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Mailbox>> mailboxes;
+    std::unordered_map<std::string, std::shared_ptr<const Listeners>> streams; // By correlation ID
+    std::unordered_map<std::string, std::string> streamIds;                    // Subscription key -> correlation ID
+    uint64_t nextId = 0;
+    uint64_t nextListenerId = 0;
+};
+
+std::map<std::string, RateLimit> default_rate_limits() {
+    // {requests_per_second, burst, weights}: roughly 80% of each exchange's public per-IP quota.
+    // Weights are the exchange's documented request weight; the scheduler caps them at the
+    // burst, so an all-symbol ticker call drains the bucket rather than counting as 1.
+    return {
+        {"ascendex", {8, 16, {}}},
+        {"binance", {20, 40, {{"/api/v3/ticker/24hr", 80}}}},
+        {"binance-coin-futures", {20, 40, {{"/dapi/v1/ticker/24hr", 40}}}},
+        {"binance-us", {10, 20, {{"/api/v3/exchangeInfo", 10}, {"/api/v3/ticker/24hr", 40}}}},
+        {"binance-usds-futures", {20, 40, {{"/fapi/v1/ticker/24hr", 40}}}},
+        {"bitfinex", {1.5, 5, {}}},
+        {"bitget", {10, 20, {}}},
+        {"bitget-futures", {10, 20, {}}},
+        {"bitmart", {8, 10, {}}},
+        {"bitmex", {0.5, 5, {}}},
+        {"bitstamp", {10, 20, {}}},
+        {"bybit", {10, 20, {}}},
+        {"coinbase", {8, 15, {}}},
+        {"cryptocom", {10, 20, {}}},
+        {"deribit", {10, 20, {}}},
+        {"gateio", {15, 30, {}}},
+        {"gateio-perpetual-futures", {15, 30, {}}},
+        {"gemini", {1.5, 5, {}}},
+        {"huobi", {10, 20, {}}},
+        {"huobi-coin-swap", {10, 20, {}}},
+        {"huobi-usdt-swap", {10, 20, {}}},
+        {"kraken", {1, 15, {}}},
+        {"kraken-futures", {5, 10, {}}},
+        {"kucoin", {10, 20, {{"/api/v1/market/allTickers", 15}}}},
+        {"kucoin-futures", {5, 10, {}}},
+        {"mexc", {10, 20, {}}},
+        {"mexc-futures", {10, 20, {}}},
+        {"okx", {8, 10, {}}},
+        {"whitebit", {10, 20, {}}},
+    };
+}
+
+// Per-exchange token buckets. A request that fits in its bucket is sent from the
+// caller's thread; otherwise it is queued and a scheduler thread (started on first
+// use) sends it when enough tokens have been refilled. Queues are FIFO per exchange.
+class UnifiedSession::Scheduler {
+public:
+    Scheduler(ccapi::Session* session, Router& router) : session(session), router(router) {}
+
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        if (thread.joinable()) thread.join();
+        // Requests still queued are never sent; let their waiters run into their deadline.
+        for (auto& entry : buckets) {
+            for (const auto& request : entry.second.queue) {
+                router.markDispatched(request.getCorrelationId());
+            }
+        }
+    }
+
+    void setLimit(const std::string& exchange, const RateLimit& limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Bucket& bucket = buckets[exchange];
+        bucket.limit = limit;
+        bucket.tokens = limit.burst;
+        bucket.refilledAt = std::chrono::steady_clock::now();
+        wakeup.notify_all();
+    }
+
+    void submit(ccapi::Request& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = buckets.find(request.getExchange());
+            if (it != buckets.end() && it->second.limit.requests_per_second > 0) {
+                Bucket& bucket = it->second;
+                double weight = weightOf(bucket, request);
+                refill(bucket, std::chrono::steady_clock::now());
+                if (!bucket.queue.empty() || bucket.tokens < weight) {
+                    router.markQueued(request.getCorrelationId());
+                    bucket.queue.push_back(request);
+                    if (!thread.joinable()) thread = std::thread([this] { run(); });
+                    wakeup.notify_all();
+                    return;
+                }
+                bucket.tokens -= weight;
+            }
+        }
+        session->sendRequest(request);
+    }
+
+private:
+    struct Bucket {
+        RateLimit limit;
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point refilledAt;
+        std::deque<ccapi::Request> queue;
+    };
+
+    static double weightOf(const Bucket& bucket, const ccapi::Request& request) {
+        double weight = 1.0;
+        for (const auto& param : request.getParamList()) {
+            auto path = param.find(CCAPI_HTTP_PATH);
+            if (path == param.end()) continue;
+            auto it = bucket.limit.weights.find(path->second);
+            if (it != bucket.limit.weights.end()) weight = it->second;
+        }
+        // A weight above the bucket capacity could never be satisfied.
+        return std::min(weight, bucket.limit.burst);
+    }
+
+    static void refill(Bucket& bucket, std::chrono::steady_clock::time_point now) {
+        double elapsed = std::chrono::duration<double>(now - bucket.refilledAt).count();
+        bucket.tokens = std::min(bucket.limit.burst, bucket.tokens + elapsed * bucket.limit.requests_per_second);
+        bucket.refilledAt = now;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            auto now = std::chrono::steady_clock::now();
+            auto nextWake = now + std::chrono::seconds(60);
+            std::vector<ccapi::Request> ready;
+
+            for (auto& entry : buckets) {
+                Bucket& bucket = entry.second;
+                if (bucket.queue.empty()) continue;
+                refill(bucket, now);
+                while (!bucket.queue.empty()) {
+                    ccapi::Request& front = bucket.queue.front();
+                    // The caller gave up (PendingRequest destroyed): drop it without spending tokens.
+                    if (!router.isOpen(front.getCorrelationId())) {
+                        bucket.queue.pop_front();
+                        continue;
+                    }
+                    // A limit disabled while requests were queued releases them all.
+                    if (bucket.limit.requests_per_second <= 0) {
+                        ready.push_back(std::move(front));
+                        bucket.queue.pop_front();
+                        continue;
+                    }
+                    double weight = weightOf(bucket, front);
+                    if (bucket.tokens < weight) {
+                        auto wait = std::chrono::duration<double>((weight - bucket.tokens) / bucket.limit.requests_per_second);
+                        nextWake = std::min(nextWake, now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+                        break;
+                    }
+                    bucket.tokens -= weight;
+                    ready.push_back(std::move(front));
+                    bucket.queue.pop_front();
+                }
+            }
+
+            if (!ready.empty()) {
+                lock.unlock();
+                for (auto& request : ready) {
+                    router.markDispatched(request.getCorrelationId());
+                    session->sendRequest(request);
+                }
+                lock.lock();
+                continue;
+            }
+            wakeup.wait_until(lock, nextWake);
+        }
+    }
+
+    ccapi::Session* session;
+    Router& router;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::unordered_map<std::string, Bucket> buckets;
+    std::thread thread;
+    bool stopping = false;
+};
+
+UnifiedSession::PendingRequest::PendingRequest(UnifiedSession* session, std::string correlationId)
+    : session(session), correlationId(std::move(correlationId)) {}
+
+UnifiedSession::PendingRequest::PendingRequest(PendingRequest&& other) noexcept
+    : session(other.session), correlationId(std::move(other.correlationId)) {
+    other.session = nullptr;
+}
+
+UnifiedSession::PendingRequest& UnifiedSession::PendingRequest::operator=(PendingRequest&& other) noexcept {
+    if (this != &other) {
+        if (session) session->release(correlationId);
+        session = other.session;
+        correlationId = std::move(other.correlationId);
+        other.session = nullptr;
+    }
+    return *this;
+}
+
+UnifiedSession::PendingRequest::~PendingRequest() {
+    if (session) session->release(correlationId);
+}
+
+std::vector<ccapi::Event> UnifiedSession::PendingRequest::wait(std::chrono::steady_clock::time_point deadline) {
+    if (!session) return {};
+    return session->router->wait(correlationId, deadline);
+}
+
+UnifiedSession::Stream::Stream(std::weak_ptr<Router> router, std::string correlationId, uint64_t listenerId)
+    : router(std::move(router)), correlationId(std::move(correlationId)), listenerId(listenerId) {}
+
+UnifiedSession::Stream::Stream(Stream&& other) noexcept
+    : router(std::move(other.router)), correlationId(std::move(other.correlationId)), listenerId(other.listenerId) {
+    other.listenerId = 0;
+}
+
+UnifiedSession::Stream& UnifiedSession::Stream::operator=(Stream&& other) noexcept {
+    if (this != &other) {
+        close();
+        router = std::move(other.router);
+        correlationId = std::move(other.correlationId);
+        listenerId = other.listenerId;
+        other.listenerId = 0;
+    }
+    return *this;
+}
+
+UnifiedSession::Stream::~Stream() {
+    close();
+}
+
+void UnifiedSession::Stream::close() {
+    if (listenerId == 0) return;
+    if (auto live = router.lock()) live->detach(correlationId, listenerId);
+    listenerId = 0;
+}
+
+UnifiedSession::UnifiedSession(const ccapi::SessionOptions& options, const ccapi::SessionConfigs& configs, ccapi::EventHandler* eventHandler)
+    : router(std::make_shared<Router>(eventHandler)) {
+    // The router is the session's event handler; the caller's handler only sees unrouted events.
+    session = new ccapi::Session(options, configs, router.get());
+    scheduler = std::make_unique<Scheduler>(session, *router);
+    for (const auto& entry : default_rate_limits()) {
+        scheduler->setLimit(entry.first, entry.second);
+    }
 }
 
 UnifiedSession::~UnifiedSession() {
+    // Stop dispatching queued requests before the session goes away.
+    scheduler.reset();
     if (session) {
         session->stop();
         delete session;
     }
 }
 
-void UnifiedSession::sendRequest(ccapi::Request& request) {
-    session->sendRequest(request);
+UnifiedSession::PendingRequest UnifiedSession::sendRequest(ccapi::Request& request) {
+    // The router owns correlation IDs so that concurrent requests never collide.
+    std::string correlationId = router->open();
+    request.setCorrelationId(correlationId);
+    scheduler->submit(request);
+    return PendingRequest(this, correlationId);
+}
+
+UnifiedSession::FanOutResult UnifiedSession::fanOut(std::vector<ccapi::Request>& requests, std::chrono::steady_clock::duration timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::vector<PendingRequest> pendings;
+    pendings.reserve(requests.size());
+    for (auto& request : requests) {
+        pendings.push_back(sendRequest(request));
+    }
+
+    // All requests are already in flight, so waiting on them in order costs the slowest round trip.
+    FanOutResult result;
+    result.messages.resize(requests.size());
+    for (size_t i = 0; i < pendings.size(); ++i) {
+        bool done = false;
+        while (!done) {
+            // wait() only comes back empty once the deadline (plus any rate-limit queueing) has passed.
+            std::vector<ccapi::Event> events = pendings[i].wait(deadline);
+            if (events.empty()) break;
+            for (const auto& event : events) {
+                if (event.getType() != ccapi::Event::Type::RESPONSE) continue;
+                for (const auto& message : event.getMessageList()) {
+                    if (message.getType() == ccapi::Message::Type::RESPONSE_ERROR ||
+                        message.getType() == ccapi::Message::Type::GENERIC_ERROR) {
+                        std::string reason = "response error";
+                        for (const auto& element : message.getElementList()) {
+                            if (element.has(CCAPI_ERROR_MESSAGE)) reason = element.getValue(CCAPI_ERROR_MESSAGE);
+                        }
+                        result.failures.push_back({i, false, reason});
+                    } else {
+                        result.messages[i].push_back(message);
+                    }
+                }
+                done = true;
+            }
+        }
+        if (!done) {
+            result.failures.push_back({i, true, "no response before deadline"});
+        }
+    }
+    return result;
+}
+
+UnifiedSession::Stream UnifiedSession::subscribe(const std::string& exchange, const std::string& instrument,
+                                                 const std::string& field, const std::string& options,
+                                                 StreamListener listener) {
+    const std::string key = exchange + '\n' + instrument + '\n' + field + '\n' + options;
+    uint64_t listenerId = 0;
+    bool isNew = false;
+    std::string correlationId = router->attach(key, std::move(listener), listenerId, isNew);
+    if (isNew) {
+        ccapi::Subscription subscription(exchange, instrument, field, options, correlationId);
+        session->subscribe(subscription);
+    }
+    return Stream(router, correlationId, listenerId);
 }
 
 void UnifiedSession::stop() {
     session->stop();
 }
 
-ccapi::Queue<ccapi::Event>& UnifiedSession::getEventQueue() {
-    return session->getEventQueue();
+void UnifiedSession::setRateLimit(const std::string& exchange, const RateLimit& limit) {
+    scheduler->setLimit(exchange, limit);
+}
+
+void UnifiedSession::release(const std::string& correlationId) {
+    router->close(correlationId);
 }
 
 }
@@ -0,0 +1,56 @@
+#include "nccapi/symbol_table.hpp"
+#include <cstring>
+
+namespace nccapi {
+
+SymbolTable::SymbolTable() {
+    names_.emplace_back();
+    ids_.emplace(std::string_view(), kEmpty);
+}
+
+SymbolId SymbolTable::intern(std::string_view text) {
+    auto it = ids_.find(text);
+    if (it != ids_.end()) return it->second;
+
+    std::string_view stored(store(text), text.size());
+    SymbolId id = static_cast<SymbolId>(names_.size());
+    names_.push_back(stored);
+    ids_.emplace(stored, id);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view text) const {
+    auto it = ids_.find(text);
+    return it == ids_.end() ? kNotFound : it->second;
+}
+
+size_t SymbolTable::memory_usage() const {
+    size_t bytes = block_bytes_ + names_.capacity() * sizeof(std::string_view);
+    // Node per entry plus the bucket array.
+    bytes += ids_.size() * (sizeof(std::string_view) + sizeof(SymbolId) + 2 * sizeof(void*));
+    bytes += ids_.bucket_count() * sizeof(void*);
+    return bytes;
+}
+
+const char* SymbolTable::store(std::string_view text) {
+    if (text.size() > kBlockSize) {
+        // Oversized strings get a block of their own, kept before the current one.
+        std::unique_ptr<char[]> block(new char[text.size()]);
+        block_bytes_ += text.size();
+        std::memcpy(block.get(), text.data(), text.size());
+        const char* data = block.get();
+        blocks_.insert(blocks_.empty() ? blocks_.end() : blocks_.end() - 1, std::move(block));
+        return data;
+    }
+    if (kBlockSize - block_used_ < text.size()) {
+        blocks_.emplace_back(new char[kBlockSize]);
+        block_bytes_ += kBlockSize;
+        block_used_ = 0;
+    }
+    char* data = blocks_.back().get() + block_used_;
+    std::memcpy(data, text.data(), text.size());
+    block_used_ += text.size();
+    return data;
+}
+
+} // namespace nccapi
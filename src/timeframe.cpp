@@ -0,0 +1,97 @@
+#include "nccapi/timeframe.hpp"
+#include <algorithm>
+
+namespace nccapi {
+
+namespace {
+    int64_t floor_div(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+    }
+
+    // Days since 1970-01-01 <-> proleptic Gregorian (year, month 1-12), day 1 of the month.
+    void civil_from_days(int64_t days, int64_t& year, int64_t& month) {
+        days += 719468;
+        const int64_t era = floor_div(days, 146097);
+        const int64_t doe = days - era * 146097;
+        const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64_t mp = (5 * doy + 2) / 153;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    }
+
+    int64_t days_from_civil(int64_t year, int64_t month) {
+        year -= month <= 2 ? 1 : 0;
+        const int64_t era = floor_div(year, 400);
+        const int64_t yoe = year - era * 400;
+        const int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5;
+        const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+}
+
+int64_t Timeframe::bucket_start(int64_t timestamp_ms) const {
+    if (unit_ != Unit::Month) {
+        const int64_t anchor = anchor_ms();
+        return anchor + floor_div(timestamp_ms - anchor, ms()) * ms();
+    }
+    int64_t year = 0;
+    int64_t month = 0;
+    civil_from_days(floor_div(timestamp_ms, kDayMs), year, month);
+    int64_t index = (year - 1970) * 12 + (month - 1);
+    index -= ((index % count_) + count_) % count_;
+    return days_from_civil(1970 + floor_div(index, 12), index - floor_div(index, 12) * 12 + 1) * kDayMs;
+}
+
+int64_t Timeframe::bucket_end(int64_t timestamp_ms) const {
+    const int64_t start = bucket_start(timestamp_ms);
+    if (unit_ != Unit::Month) return start + ms();
+    // count_ * 31 days always lands inside the next bucket, never past it.
+    return bucket_start(start + static_cast<int64_t>(count_) * 31 * kDayMs);
+}
+
+const NativeTimeframe& TimeframeTable::require(Timeframe timeframe, std::string_view exchange) const {
+    if (const NativeTimeframe* entry = find(timeframe)) return *entry;
+    throw std::invalid_argument(std::string(exchange) + " does not serve " + timeframe.to_string() +
+                                " candles (native: " + to_string() + ")");
+}
+
+std::optional<Timeframe> TimeframeTable::source_for(Timeframe target) const {
+    if (const NativeTimeframe* entry = find(target)) return entry->timeframe;
+    std::optional<Timeframe> best;
+    for (const auto& entry : *this) {
+        if (target.is_multiple_of(entry.timeframe) && (!best || *best < entry.timeframe)) best = entry.timeframe;
+    }
+    return best;
+}
+
+std::string TimeframeTable::to_string() const {
+    std::string out;
+    for (const auto& entry : *this) {
+        if (!out.empty()) out += ", ";
+        out += entry.timeframe.to_string();
+    }
+    return out;
+}
+
+std::vector<Candle> resample_candles(const std::vector<Candle>& candles, Timeframe target) {
+    std::vector<Candle> out;
+    for (const auto& candle : candles) {
+        const uint64_t bucket = static_cast<uint64_t>(target.bucket_start(static_cast<int64_t>(candle.timestamp)));
+        if (out.empty() || out.back().timestamp != bucket) {
+            Candle next = candle;
+            next.timestamp = bucket;
+            out.push_back(next);
+            continue;
+        }
+        Candle& current = out.back();
+        current.high = std::max(current.high, candle.high);
+        current.low = std::min(current.low, candle.low);
+        current.close = candle.close;
+        current.volume += candle.volume;
+    }
+    return out;
+}
+
+} // namespace nccapi
@@ -0,0 +1,105 @@
+#include "nccapi/trade_stream.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace nccapi {
+
+TradeAggregator::TradeAggregator(std::string exchange,
+                                 std::string instrument,
+                                 Timeframe timeframe,
+                                 CandleHandler handler,
+                                 TradeAggregatorOptions options)
+    : exchange_(std::move(exchange)), instrument_(std::move(instrument)), timeframe_(timeframe),
+      handler_(std::move(handler)), options_(options) {}
+
+void TradeAggregator::set_scheduler(Scheduler scheduler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scheduler_ = std::move(scheduler);
+    scheduled_ = kNoDeadline;
+    schedule();
+}
+
+void TradeAggregator::add(const Trade& trade) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t timestamp = static_cast<int64_t>(trade.timestamp);
+    const uint64_t bucket = static_cast<uint64_t>(timeframe_.bucket_start(timestamp));
+    if (started_) {
+        if (bucket < current_.timestamp || (bucket == current_.timestamp && !open_)) {
+            ++late_trades_;
+            return;
+        }
+        if (bucket == current_.timestamp) {
+            current_.high = std::max(current_.high, trade.price);
+            current_.low = std::min(current_.low, trade.price);
+            current_.close = trade.price;
+            current_.volume += trade.size;
+            emit(false);
+            return;
+        }
+        close_through(static_cast<int64_t>(bucket));
+    }
+    current_.timestamp = bucket;
+    current_.open = current_.high = current_.low = current_.close = trade.price;
+    current_.volume = trade.size;
+    end_ = timeframe_.bucket_end(timestamp);
+    started_ = true;
+    open_ = true;
+    emit(false);
+    schedule();
+}
+
+void TradeAggregator::advance(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_) return;
+    const int64_t delay = options_.close_delay.count();
+    if (open_ && now_ms >= end_ + delay) emit(true);
+    if (options_.fill_gaps && !open_) {
+        while (now_ms >= timeframe_.bucket_end(end_) + delay) {
+            close_through(timeframe_.bucket_end(end_));
+        }
+    }
+    schedule();
+}
+
+uint64_t TradeAggregator::late_trades() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return late_trades_;
+}
+
+void TradeAggregator::close_through(int64_t bucket) {
+    if (open_) emit(true);
+    if (!options_.fill_gaps) return;
+    while (end_ < bucket) {
+        current_.timestamp = static_cast<uint64_t>(end_);
+        current_.open = current_.high = current_.low = current_.close;
+        current_.volume = 0.0;
+        end_ = timeframe_.bucket_end(end_);
+        emit(true);
+    }
+}
+
+void TradeAggregator::schedule() {
+    if (!scheduler_) return;
+    int64_t deadline = kNoDeadline;
+    if (open_) {
+        deadline = end_ + options_.close_delay.count();
+    } else if (options_.fill_gaps && started_) {
+        deadline = timeframe_.bucket_end(end_) + options_.close_delay.count();
+    }
+    if (deadline == kNoDeadline || deadline == scheduled_) return;
+    scheduled_ = deadline;
+    scheduler_(deadline);
+}
+
+void TradeAggregator::emit(bool closed) {
+    if (closed) open_ = false;
+    CandleUpdate update;
+    update.exchange = exchange_;
+    update.instrument = instrument_;
+    update.timeframe = timeframe_;
+    update.candle = current_;
+    update.closed = closed;
+    handler_(update);
+}
+
+} // namespace nccapi
@@ -0,0 +1,119 @@
+// Compares the previous price/size parsing path (std::string copy + std::stod inside try/catch)
+// with nccapi::parse_decimal on the fields of real Binance and OKX REST payloads.
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "rapidjson/document.h"
+#include "nccapi/decimal.hpp"
+
+namespace {
+
+// GET /api/v3/exchangeInfo (one symbol, trimmed to the filters the exchange classes read)
+const char* kBinanceExchangeInfo = R"({"timezone":"UTC","serverTime":1718000000000,"symbols":[
+{"symbol":"BTCUSDT","status":"TRADING","baseAsset":"BTC","quoteAsset":"USDT","filters":[
+{"filterType":"PRICE_FILTER","minPrice":"0.01000000","maxPrice":"1000000.00000000","tickSize":"0.01000000"},
+{"filterType":"LOT_SIZE","minQty":"0.00001000","maxQty":"9000.00000000","stepSize":"0.00001000"},
+{"filterType":"NOTIONAL","minNotional":"5.00000000","maxNotional":"9000000.00000000"}]}]})";
+
+// GET /api/v3/klines?symbol=BTCUSDT&interval=1m
+const char* kBinanceKlines = R"([
+[1718000040000,"69534.01000000","69551.99000000","69521.23000000","69530.00000000","18.74511000",1718000099999,"1303569.91584130",2145,"9.07126000","630862.41203520","0"],
+[1718000100000,"69530.00000000","69533.34000000","69490.00000000","69492.36000000","21.04470000",1718000159999,"1462940.90815870",2461,"6.54329000","454848.79812530","0"]])";
+
+// GET /api/v5/public/instruments?instType=SWAP
+const char* kOkxInstruments = R"({"code":"0","msg":"","data":[
+{"instId":"BTC-USDT-SWAP","instType":"SWAP","baseCcy":"","quoteCcy":"","settleCcy":"USDT","ctVal":"0.01","ctMult":"1","lotSz":"0.01","minSz":"0.01","tickSz":"0.1","state":"live"},
+{"instId":"ETH-USDT-SWAP","instType":"SWAP","baseCcy":"","quoteCcy":"","settleCcy":"USDT","ctVal":"0.1","ctMult":"1","lotSz":"0.01","minSz":"0.01","tickSz":"0.01","state":"live"}]})";
+
+// GET /api/v5/market/history-candles?instId=BTC-USDT
+const char* kOkxCandles = R"({"code":"0","msg":"","data":[
+["1718000040000","69534.1","69552","69521.2","69530","18.74511","1303569.915841","1303569.915841","1"],
+["1718000100000","69530","69533.3","69490","69492.4","21.0447","1462940.908158","1462940.908158","1"]]})";
+
+// Collect every string value of a payload: these are the fields the decoders convert.
+void collect_strings(const rapidjson::Value& value, std::vector<std::string>& out) {
+    if (value.IsString()) {
+        out.emplace_back(value.GetString(), value.GetStringLength());
+    } else if (value.IsArray()) {
+        for (const auto& item : value.GetArray()) collect_strings(item, out);
+    } else if (value.IsObject()) {
+        for (const auto& member : value.GetObject()) collect_strings(member.value, out);
+    }
+}
+
+std::vector<std::string> payload_fields(const char* json) {
+    rapidjson::Document doc;
+    doc.Parse(json);
+    std::vector<std::string> fields;
+    if (!doc.HasParseError()) collect_strings(doc, fields);
+    return fields;
+}
+
+template <typename F>
+double time_ns_per_field(const std::vector<std::string>& fields, int rounds, F&& parse, double& sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& field : fields) sink += parse(field.c_str());
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(rounds) * fields.size());
+}
+
+// The path the exchange classes used before: copy into a std::string, stod, swallow failures.
+double stod_path(const char* text) {
+    std::string value = text;
+    double out = 0.0;
+    if (!value.empty()) { try { out = std::stod(value); } catch(...) {} }
+    return out;
+}
+
+double from_chars_path(const char* text) {
+    double out = 0.0;
+    nccapi::parse_decimal(text, out);
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    struct Payload { const char* name; const char* json; };
+    const Payload payloads[] = {
+        {"binance exchangeInfo", kBinanceExchangeInfo},
+        {"binance klines", kBinanceKlines},
+        {"okx instruments", kOkxInstruments},
+        {"okx candles", kOkxCandles},
+    };
+
+    double sink = 0.0;
+    std::cout << std::left << std::setw(24) << "payload" << std::right
+              << std::setw(8) << "fields" << std::setw(14) << "stod ns" << std::setw(14) << "from_chars ns"
+              << std::setw(10) << "speedup" << std::endl;
+    for (const auto& payload : payloads) {
+        auto fields = payload_fields(payload.json);
+        if (fields.empty()) {
+            std::cerr << "Could not parse " << payload.name << std::endl;
+            return 1;
+        }
+        // Both paths must agree on every field, numeric or not.
+        for (const auto& field : fields) {
+            if (stod_path(field.c_str()) != from_chars_path(field.c_str())) {
+                std::cerr << "Mismatch on \"" << field << "\" in " << payload.name << std::endl;
+                return 1;
+            }
+        }
+        double stod_ns = time_ns_per_field(fields, rounds, stod_path, sink);
+        double fast_ns = time_ns_per_field(fields, rounds, from_chars_path, sink);
+        std::cout << std::left << std::setw(24) << payload.name << std::right
+                  << std::setw(8) << fields.size()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << stod_ns
+                  << std::setw(14) << fast_ns
+                  << std::setw(9) << std::setprecision(2) << (stod_ns / fast_ns) << "x" << std::endl;
+    }
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
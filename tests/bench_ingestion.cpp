@@ -0,0 +1,189 @@
+// Counts heap allocations per instrument while a get_instruments-style loop decodes a catalog:
+// the previous path (local Instrument, info map, push_back copy into a growing vector)
+// against CatalogBuilder (reserve, in-place emplace, shared info arena).
+// Rows mimic ccapi's Element::getNameValueMap() for an OKX SWAP instrument.
+// Exits non-zero when CatalogBuilder exceeds the fixed per-row allocation budget of a mode;
+// the previous path is printed for reference only.
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "nccapi/decimal.hpp"
+#include "nccapi/sessions/catalog_builder.hpp"
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Row = std::map<std::string_view, std::string>;
+
+std::vector<Row> make_rows(size_t count) {
+    static const char* bases[] = {"BTC", "ETH", "SOL", "XRP", "DOGE", "ADA", "AVAX", "LINK"};
+    std::vector<Row> rows(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string base = std::string(bases[i % 8]) + (i >= 8 ? std::to_string(i) : "");
+        Row& row = rows[i];
+        row["instId"] = base + "-USDT-SWAP";
+        row["instType"] = "SWAP";
+        row["baseCcy"] = "";
+        row["quoteCcy"] = "";
+        row["settleCcy"] = "USDT";
+        row["ctVal"] = "0.01";
+        row["ctMult"] = "1";
+        row["ctValCcy"] = base;
+        row["lotSz"] = "0.01";
+        row["minSz"] = "0.01";
+        row["tickSz"] = "0.1";
+        row["state"] = "live";
+        row["listTime"] = "1611916828000";
+        row["expTime"] = "";
+        row["uly"] = base + "-USDT";
+        row["instFamily"] = base + "-USDT";
+        row["maxLmtSz"] = "100000000";
+        row["maxMktSz"] = "10000";
+    }
+    return rows;
+}
+
+void fill(nccapi::Instrument& instrument, const Row& row) {
+    instrument.id = row.at("instId");
+    instrument.underlying = row.at("uly");
+    instrument.base = row.at("ctValCcy");
+    instrument.settle = row.at("settleCcy");
+    instrument.quote = instrument.settle;
+    instrument.symbol = instrument.base + "/" + instrument.quote + ":" + instrument.settle;
+    instrument.type = "swap";
+    instrument.active = row.at("state") == "live";
+    instrument.tick_size = nccapi::decimal_or(row.at("tickSz"), 0.0);
+    instrument.step_size = nccapi::decimal_or(row.at("lotSz"), 0.0);
+    instrument.min_size = nccapi::decimal_or(row.at("minSz"), 0.0);
+    instrument.contract_size = nccapi::decimal_or(row.at("ctVal"), 0.0);
+}
+
+// The loop every exchange class ran before CatalogBuilder.
+std::vector<nccapi::Instrument> previous_path(const std::vector<Row>& rows, nccapi::InfoMode mode) {
+    std::vector<nccapi::Instrument> instruments;
+    nccapi::InfoCollector info(mode);
+    for (const auto& row : rows) {
+        nccapi::Instrument instrument;
+        fill(instrument, row);
+        info.assign(instrument.info, row);
+        instruments.push_back(instrument);
+    }
+    return instruments;
+}
+
+std::vector<nccapi::Instrument> builder_path(const std::vector<Row>& rows, nccapi::InfoMode mode) {
+    nccapi::CatalogBuilder catalog(mode);
+    catalog.reserve(rows.size());
+    for (const auto& row : rows) {
+        nccapi::Instrument& instrument = catalog.emplace();
+        fill(instrument, row);
+        catalog.assign_info(instrument, row);
+    }
+    return catalog.finish();
+}
+
+struct Measure {
+    double allocations_per_row;
+    double ns_per_row;
+};
+
+template <typename F>
+Measure measure(const std::vector<Row>& rows, int rounds, F&& load) {
+    size_t allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        size_t before = g_allocations.load(std::memory_order_relaxed);
+        auto instruments = load(rows);
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+        if (instruments.size() != rows.size()) std::abort();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double total = static_cast<double>(rounds) * rows.size();
+    return Measure{allocations / total, elapsed / total};
+}
+
+// CatalogBuilder's allocations per row on these rows (18 fields): the strings that outgrow
+// the small-string buffer, plus one node per info field in InfoMode::Eager. Slack covers
+// vector growth of the shared arena; a new allocation per row breaks the budget.
+// kPerCallAllocations (catalog vector, arena, interned keys) is spread over the rows.
+constexpr double kPerCallAllocations = 64.0;
+
+double allocation_budget(nccapi::InfoMode mode, size_t rows) {
+    double per_row = 0.0;
+    switch (mode) {
+        case nccapi::InfoMode::Eager: per_row = 21.25; break;
+        case nccapi::InfoMode::Lazy: per_row = 2.25; break;
+        case nccapi::InfoMode::Skip: per_row = 2.25; break;
+    }
+    return per_row + kPerCallAllocations / static_cast<double>(rows);
+}
+
+const char* mode_name(nccapi::InfoMode mode) {
+    switch (mode) {
+        case nccapi::InfoMode::Eager: return "eager";
+        case nccapi::InfoMode::Lazy: return "lazy";
+        case nccapi::InfoMode::Skip: return "skip";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    const std::vector<Row> rows = make_rows(count);
+
+    // Both paths must produce the same catalog.
+    auto expected = previous_path(rows, nccapi::InfoMode::Eager);
+    auto actual = builder_path(rows, nccapi::InfoMode::Lazy);
+    for (size_t i = 0; i < count; ++i) {
+        if (expected[i].id != actual[i].id || expected[i].symbol != actual[i].symbol ||
+            expected[i].tick_size != actual[i].tick_size || expected[i].info.map() != actual[i].info.map()) {
+            std::cerr << "Mismatch on row " << i << " (" << expected[i].id << ")" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << count << " instruments, " << rows.front().size() << " raw fields each" << std::endl;
+    std::cout << std::left << std::setw(8) << "info" << std::right
+              << std::setw(16) << "previous alloc" << std::setw(16) << "builder alloc"
+              << std::setw(14) << "previous ns" << std::setw(14) << "builder ns" << std::setw(10) << "budget" << std::endl;
+    bool regressed = false;
+    for (auto mode : {nccapi::InfoMode::Eager, nccapi::InfoMode::Lazy, nccapi::InfoMode::Skip}) {
+        Measure before = measure(rows, rounds, [mode](const std::vector<Row>& r) { return previous_path(r, mode); });
+        Measure after = measure(rows, rounds, [mode](const std::vector<Row>& r) { return builder_path(r, mode); });
+        const double budget = allocation_budget(mode, count);
+        std::cout << std::left << std::setw(8) << mode_name(mode) << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << before.allocations_per_row << std::setw(16) << after.allocations_per_row
+                  << std::setprecision(1)
+                  << std::setw(14) << before.ns_per_row << std::setw(14) << after.ns_per_row
+                  << std::setprecision(2) << std::setw(10) << budget << std::endl;
+        if (after.allocations_per_row > budget) {
+            std::cerr << "CatalogBuilder (" << mode_name(mode) << ") allocated " << after.allocations_per_row
+                      << " times per row, budget " << budget << std::endl;
+            regressed = true;
+        }
+    }
+    if (regressed) return 1;
+    return 0;
+}
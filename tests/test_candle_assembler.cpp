@@ -0,0 +1,125 @@
+// Offline check of CandleAssembler: forming snapshots, roll-over to the next bar, closes
+// driven by the clock and by a DeadlineTimer, late snapshots after a close, and
+// cancelled timer tasks.
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "nccapi/candle_stream.hpp"
+#include "nccapi/deadline_timer.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Candle;
+using nccapi::CandleAssembler;
+using nccapi::CandleUpdate;
+using nccapi::test::check;
+using nccapi::test::same;
+using namespace nccapi::literals;
+
+Candle snapshot(uint64_t timestamp, double close, double volume) {
+    Candle c;
+    c.timestamp = timestamp;
+    c.open = 100.0;
+    c.high = close > 100.0 ? close : 100.0;
+    c.low = close < 100.0 ? close : 100.0;
+    c.close = close;
+    c.volume = volume;
+    return c;
+}
+
+struct Recorder {
+    std::mutex mutex;
+    std::vector<CandleUpdate> closed;
+    size_t forming = 0;
+    nccapi::CandleHandler handler() {
+        return [this](const CandleUpdate& update) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (update.closed) closed.push_back(update);
+            else ++forming;
+        };
+    }
+};
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const uint64_t kT0 = 1718000040000ULL; // 2024-06-10 06:14:00 UTC, a minute boundary
+
+} // namespace
+
+int main() {
+    {
+        Recorder bars;
+        std::vector<int64_t> deadlines;
+        CandleAssembler assembler("test", "BTC-USD", "1m"_tf, bars.handler());
+        assembler.set_scheduler([&deadlines](int64_t deadline_ms) { deadlines.push_back(deadline_ms); });
+        assembler.update(snapshot(kT0, 101.0, 1.0));
+        assembler.update(snapshot(kT0 + 30000, 102.0, 2.0)); // Same bar, stamped mid-bar
+        check(bars.closed.empty() && bars.forming == 2, "snapshots of the forming bar");
+        check(deadlines.size() == 1 && deadlines[0] == static_cast<int64_t>(kT0) + 60000 + 250,
+              "one close scheduled per bar, at end + close_delay");
+
+        assembler.advance(static_cast<int64_t>(kT0) + 60000 + 249);
+        check(bars.closed.empty(), "not closed before end + close_delay");
+        assembler.advance(static_cast<int64_t>(kT0) + 60000 + 250);
+        check(bars.closed.size() == 1 && bars.closed[0].candle.timestamp == kT0 &&
+              same(bars.closed[0].candle.close, 102.0) && same(bars.closed[0].candle.volume, 2.0),
+              "clock closes the bar with its last snapshot");
+
+        assembler.update(snapshot(kT0, 103.0, 3.0));
+        assembler.advance(static_cast<int64_t>(kT0) + 120000);
+        check(bars.closed.size() == 1 && bars.forming == 2, "late snapshot of a closed bar is dropped");
+
+        assembler.update(snapshot(kT0 + 60000, 99.0, 1.0));
+        assembler.update(snapshot(kT0 + 120000, 98.0, 0.5)); // Next bar before the timer fired
+        check(bars.closed.size() == 2 && bars.closed[1].candle.timestamp == kT0 + 60000 &&
+              same(bars.closed[1].candle.close, 99.0), "first snapshot of the next bar closes the previous one");
+        check(deadlines.size() == 3 && deadlines[2] == static_cast<int64_t>(kT0) + 180000 + 250, "roll-over reschedules");
+        assembler.update(snapshot(kT0 + 60000, 97.0, 9.0));
+        check(bars.closed.size() == 2 && bars.forming == 4, "snapshot of a replaced bar is dropped");
+        assembler.close();
+        assembler.close();
+        check(bars.closed.size() == 3 && bars.closed[2].candle.timestamp == kT0 + 120000, "close() delivers once");
+    }
+
+    {
+        // A DeadlineTimer closes the bar on time without any further snapshot.
+        Recorder bars;
+        auto timer = std::make_shared<nccapi::DeadlineTimer>();
+        auto assembler = std::make_shared<CandleAssembler>("test", "BTC-USD", "1s"_tf, bars.handler(),
+                                                           std::chrono::milliseconds(50));
+        std::weak_ptr<CandleAssembler> weak = assembler;
+        assembler->set_scheduler([timer, weak](int64_t deadline_ms) {
+            timer->schedule(deadline_ms, [weak] {
+                if (auto target = weak.lock()) target->advance(now_ms());
+            });
+        });
+        const int64_t start = now_ms();
+        assembler->update(snapshot(static_cast<uint64_t>(start), 101.0, 1.0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+        assembler->update(snapshot(static_cast<uint64_t>(start), 104.0, 1.0));
+        std::lock_guard<std::mutex> lock(bars.mutex);
+        check(bars.closed.size() == 1 && bars.closed[0].candle.timestamp == static_cast<uint64_t>("1s"_tf.bucket_start(start)) &&
+              same(bars.closed[0].candle.close, 101.0), "timer closes the bar after its end; later snapshot dropped");
+    }
+
+    {
+        // Cancelled timer tasks never run.
+        nccapi::DeadlineTimer timer;
+        std::atomic<int> ran{0};
+        const uint64_t cancelled = timer.schedule(now_ms() + 20, [&ran] { ran += 1; });
+        timer.schedule(now_ms() + 40, [&ran] { ran += 10; });
+        timer.cancel(cancelled);
+        timer.cancel(cancelled);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        check(cancelled != 0 && ran == 10, "cancel() discards only its task");
+    }
+
+    return nccapi::test::report("candle assembler");
+}
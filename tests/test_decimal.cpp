@@ -0,0 +1,100 @@
+// Offline check of parse_decimal / parse_optional_decimal and Decimal: parse rounding
+// and rejection, scale-independent comparison and hashing, from_double overflow, and
+// FixedCandle conversion of rows that do not fit.
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "nccapi/decimal.hpp"
+#include "nccapi/fixed_candle.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Decimal;
+using nccapi::test::check;
+
+bool parses_to(const char* text, int scale, int64_t mantissa) {
+    Decimal value;
+    return Decimal::parse(text, scale, value) && value.mantissa == mantissa && value.scale == scale;
+}
+
+bool rejects(const char* text, int scale) {
+    Decimal value(7, 1);
+    return !Decimal::parse(text, scale, value) && value.mantissa == 7 && value.scale == 1;
+}
+
+} // namespace
+
+int main() {
+    // Double parsing: rejection leaves the target untouched; optional fields accept empty text.
+    double number = 7.0;
+    check(nccapi::parse_decimal("0.00010000", number) && number == 0.0001, "parse_decimal");
+    check(!nccapi::parse_decimal("", number) && !nccapi::parse_decimal("1.5x", number) &&
+          !nccapi::parse_decimal("abc", number) && number == 0.0001, "parse_decimal rejects, out untouched");
+    number = 0.0;
+    check(nccapi::parse_optional_decimal("", number) && number == 0.0, "optional field: empty keeps the default");
+    check(!nccapi::parse_optional_decimal("n/a", number) && number == 0.0 &&
+          nccapi::parse_optional_decimal("0.5", number) && number == 0.5, "optional field: malformed text still fails");
+
+    // Parsing and rounding half away from zero on the first dropped digit.
+    check(parses_to("69534.01000000", 2, 6953401), "trailing zeros beyond the scale dropped");
+    check(parses_to("42", 3, 42000), "integer padded to the scale");
+    check(parses_to("1.", 2, 100) && parses_to(".5", 1, 5), "bare leading or trailing point");
+    check(parses_to("0.125", 2, 13) && parses_to("0.124", 2, 12), "half rounds up, below half rounds down");
+    check(parses_to("-0.125", 2, -13) && parses_to("-0.124", 2, -12), "negative rounds away from zero");
+    check(parses_to("0.1249999", 2, 12), "only the first dropped digit decides");
+    check(parses_to("0.995", 2, 100), "rounding carries into the integer part");
+    check(parses_to("+1.5", 1, 15), "leading plus");
+    check(parses_to("1.5e-8", 9, 15) && parses_to("2E3", 0, 2000), "exponent notation");
+    check(parses_to("9223372036854775807", 0, std::numeric_limits<int64_t>::max()), "largest mantissa");
+
+    check(rejects("", 2) && rejects("-", 2) && rejects(".", 2), "no digits");
+    check(rejects("1.2.3", 2) && rejects("1,5", 2) && rejects("abc", 2) && rejects(" 1", 2), "not a number");
+    check(rejects("1", -1) && rejects("1", Decimal::kMaxScale + 1), "scale out of range");
+    check(rejects("9223372036854775808", 0), "mantissa overflow");
+    check(rejects("92233720368547758.07", 3), "overflow while padding to the scale");
+    check(rejects("9223372036854775807.5", 0), "overflow while rounding");
+    check(rejects("1e300", 2), "exponent overflow");
+
+    // from_double reports what does not fit instead of returning 0.
+    Decimal value(7, 1);
+    check(Decimal::from_double(0.1 + 0.2, 2, value) && value.mantissa == 30, "from_double rounds onto the grid");
+    value = Decimal(7, 1);
+    check(!Decimal::from_double(1e300, 2, value) && value.mantissa == 7, "from_double overflow leaves out untouched");
+    check(!Decimal::from_double(std::numeric_limits<double>::quiet_NaN(), 2, value) &&
+          !Decimal::from_double(std::numeric_limits<double>::infinity(), 2, value), "from_double rejects non-finite");
+
+    nccapi::Candle candle;
+    candle.timestamp = 1;
+    candle.open = candle.high = candle.low = candle.close = 1.5;
+    candle.volume = 1e300;
+    nccapi::FixedCandle fixed;
+    check(!nccapi::FixedCandle::from_candle(candle, nccapi::FixedScale(), fixed) && fixed.timestamp == 0,
+          "FixedCandle::from_candle rejects an overflowing volume");
+    check(nccapi::FixedCandleSeries::from_candles(std::vector<nccapi::Candle>{candle}, nccapi::FixedScale()).empty(),
+          "FixedCandleSeries::from_candles skips rows that do not fit");
+
+    // Comparison by value across scales.
+    check(Decimal(150, 2) == Decimal(15, 1) && Decimal(15, 1) == Decimal(150, 2), "1.50 == 1.5");
+    check(Decimal(149, 2) < Decimal(15, 1) && Decimal(151, 2) > Decimal(15, 1), "ordering across scales");
+    check(Decimal(-5, 1) < Decimal(0, 0) && Decimal(-50, 2) == Decimal(-5, 1), "negative values");
+    check(Decimal(1, 0).compare(Decimal(1, 0)) == 0 && Decimal(1, 0).compare(Decimal(2, 0)) == -1 &&
+          Decimal(2, 0).compare(Decimal(1, 0)) == 1, "compare is three-way");
+    const Decimal huge(std::numeric_limits<int64_t>::max(), 0);
+    check(huge > Decimal(1, 18) && Decimal(1, 18) < huge, "falls back to doubles when aligning overflows");
+    check(Decimal(125, 2) + Decimal(5, 1) == Decimal(175, 2) && Decimal(1, 0) - Decimal(25, 2) == Decimal(75, 2),
+          "sum and difference at the larger scale");
+    check(Decimal(-1, 2).to_string() == "-0.01" && Decimal(150, 2).to_string() == "1.50", "to_string keeps the scale");
+
+    // Hashing agrees with equality.
+    std::hash<Decimal> hash;
+    check(hash(Decimal(150, 2)) == hash(Decimal(15, 1)) && hash(Decimal(1000, 3)) == hash(Decimal(1, 0)),
+          "equal values hash equally");
+    check(hash(Decimal(0, 0)) == hash(Decimal(0, 8)), "zero at any scale");
+    std::unordered_set<Decimal> prices{Decimal(150, 2), Decimal(15, 1), Decimal(151, 2)};
+    check(prices.size() == 2 && prices.count(Decimal(1500, 3)) == 1, "unordered_set deduplicates by value");
+
+    return nccapi::test::report("decimal");
+}
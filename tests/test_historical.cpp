@@ -7,6 +7,8 @@
 #include <algorithm>
 #include "nccapi/client.hpp"
 
+using namespace nccapi::literals;
+
 // ANSI color codes
 #define RESET   "\033[0m"
 #define RED     "\033[31m"
@@ -70,7 +72,8 @@ int main(int argc, char* argv[]) {
         try {
             // 1. Get Pairs
             std::cout << "Fetching instruments..." << std::endl;
-            auto instruments = client.get_pairs(exchange_name);
+            auto catalog = client.get_catalog(exchange_name);
+            const auto& instruments = catalog->instruments();
             std::cout << GREEN << "Success. Found " << instruments.size() << " instruments." << RESET << std::endl;
 
             if (instruments.empty()) {
@@ -83,22 +86,17 @@ int main(int argc, char* argv[]) {
             bool found = false;
 
             if (!specific_pair.empty()) {
-                for (const auto& inst : instruments) {
-                    if (inst.symbol == specific_pair || inst.id == specific_pair) {
-                        selected_inst = inst;
-                        found = true;
-                        break;
-                    }
+                if (const nccapi::Instrument* match = catalog->find(specific_pair)) {
+                    selected_inst = *match;
+                    found = true;
                 }
                 if (!found) {
-                     std::cout << YELLOW << "Specific pair '" << specific_pair << "' not found in instrument list. Trying fuzzy match..." << std::endl;
-                     for (const auto& inst : instruments) {
-                        if (inst.symbol.find(specific_pair) != std::string::npos || inst.id.find(specific_pair) != std::string::npos) {
-                            selected_inst = inst;
-                            found = true;
-                            std::cout << "Fuzzy matched: " << inst.symbol << " (ID: " << inst.id << ")" << std::endl;
-                            break;
-                        }
+                     std::cout << YELLOW << "Specific pair '" << specific_pair << "' not found in instrument list. Trying prefix match..." << std::endl;
+                     auto matches = catalog->with_prefix(specific_pair, 1);
+                     if (!matches.empty()) {
+                        selected_inst = *matches.front();
+                        found = true;
+                        std::cout << "Prefix matched: " << selected_inst.symbol << " (ID: " << selected_inst.id << ")" << std::endl;
                     }
                     if (!found && !instruments.empty()) {
                         std::cout << "[DEBUG] Available instruments (first 5): ";
@@ -116,28 +114,26 @@ int main(int argc, char* argv[]) {
                 };
 
                 for (const auto& target : priorities) {
-                    for (const auto& inst : instruments) {
-                        if (inst.symbol == target || inst.id == target) {
-                            selected_inst = inst;
-                            found = true;
-                            break;
-                        }
+                    if (const nccapi::Instrument* match = catalog->find(target)) {
+                        selected_inst = *match;
+                        found = true;
+                        break;
                     }
-                    if (found) break;
                 }
             }
 
             if (!found) {
-                // Fallback to searching for BTC/USD substring
-                for (const auto& inst : instruments) {
-                    // Convert to upper for check
-                    std::string sym = inst.symbol;
-                    std::transform(sym.begin(), sym.end(), sym.begin(), ::toupper);
-                    if ((sym.find("BTC") != std::string::npos) && (sym.find("USD") != std::string::npos)) {
-                        selected_inst = inst;
-                        found = true;
-                        break;
+                // Fallback to any BTC (or XBT) instrument quoted in USDT / USD
+                for (const char* base : {"BTC", "XBT"}) {
+                    for (const char* quote : {"USDT", "USD"}) {
+                        auto matches = catalog->select(base, quote);
+                        if (!matches.empty()) {
+                            selected_inst = *matches.front();
+                            found = true;
+                            break;
+                        }
                     }
+                    if (found) break;
                 }
             }
 
@@ -219,6 +215,24 @@ int main(int argc, char* argv[]) {
                 std::cout << YELLOW << "Warning: Returned empty candle vector (might be inactive pair or API limitation)." << RESET << std::endl;
             }
 
+            // 5. Non-native timeframes are resampled from a native one; bad ones throw up front
+            const nccapi::TimeframeTable native = client.get_exchange(exchange_name)->timeframes();
+            std::cout << "Native timeframes: " << (native.empty() ? "(not described)" : native.to_string()) << std::endl;
+            const nccapi::Timeframe four_hours = "4h"_tf;
+            auto h4 = client.get_historical_candles(exchange_name, selected_inst.id, "4h", to_ts - 2 * 86400000LL, to_ts);
+            bool aligned = std::all_of(h4.begin(), h4.end(), [&](const nccapi::Candle& c) {
+                return static_cast<int64_t>(c.timestamp) == four_hours.bucket_start(c.timestamp);
+            });
+            std::cout << (aligned ? GREEN : RED) << "4h candles: " << h4.size()
+                      << (native.supports(four_hours) ? " (native)" : " (resampled)")
+                      << (aligned ? ", aligned" : ", MISALIGNED") << RESET << std::endl;
+            try {
+                client.get_historical_candles(exchange_name, selected_inst.id, "7x", from_ts, to_ts);
+                std::cout << RED << "[FAIL] Invalid timeframe accepted" << RESET << std::endl;
+            } catch (const std::invalid_argument& e) {
+                std::cout << GREEN << "Invalid timeframe rejected: " << e.what() << RESET << std::endl;
+            }
+
         } catch (const std::exception& e) {
             std::cerr << RED << "Test Failed: " << e.what() << RESET << std::endl;
         }
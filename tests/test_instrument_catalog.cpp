@@ -0,0 +1,100 @@
+// Offline check of InstrumentCatalog: exact lookups, select() over every filter
+// combination, with_prefix() ordering, case folding, deduplication and limits, and
+// indexes that stay valid across copies and moves.
+#include <memory>
+#include <string>
+#include <vector>
+#include "nccapi/instrument_catalog.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Instrument;
+using nccapi::InstrumentCatalog;
+using nccapi::test::check;
+
+Instrument make(const char* id, const char* symbol, const char* base, const char* quote, const char* type,
+                const char* settle = "") {
+    Instrument instrument;
+    instrument.id = id;
+    instrument.symbol = symbol;
+    instrument.base = base;
+    instrument.quote = quote;
+    instrument.type = type;
+    instrument.settle = settle;
+    return instrument;
+}
+
+std::vector<Instrument> sample() {
+    return {
+        make("BTCUSDT", "BTC/USDT", "BTC", "USDT", "spot"),
+        make("ETHUSDT", "ETH/USDT", "ETH", "USDT", "spot"),
+        make("BTCUSD_PERP", "BTC/USD:BTC", "BTC", "USD", "swap", "BTC"),
+        make("BTCUSDT_PERP", "BTC/USDT:USDT", "BTC", "USDT", "swap", "USDT"),
+        make("ethbtc", "ETH/BTC", "ETH", "BTC", "spot"),
+        make("XRPUSDT", "XRPUSDT", "XRP", "USDT", "spot"), // Symbol equal to the id
+        make("BTCUSDT", "BTC/USDT-DUP", "BTC", "USDT", "spot"), // Duplicate id: the first wins
+    };
+}
+
+std::string ids(const std::vector<const Instrument*>& instruments) {
+    std::string out;
+    for (const Instrument* instrument : instruments) {
+        if (!out.empty()) out += ',';
+        out += instrument->id;
+    }
+    return out;
+}
+
+} // namespace
+
+int main() {
+    InstrumentCatalog catalog(sample());
+    check(catalog.size() == 7, "every instrument kept");
+
+    check(catalog.find_by_id("ETHUSDT") == &catalog[1], "find_by_id");
+    check(catalog.find_by_symbol("BTC/USDT:USDT") == &catalog[3], "find_by_symbol");
+    check(catalog.find("ETH/BTC") == &catalog[4] && catalog.find("ethbtc") == &catalog[4], "find: id, then symbol");
+    check(catalog.find_by_id("BTCUSDT")->symbol == "BTC/USDT", "duplicate id: the first instrument wins");
+    check(!catalog.find("DOGEUSDT") && !catalog.find_by_id("btcusdt"), "exact lookups are case-sensitive");
+
+    // select(): every non-empty filter must match, results in catalog order.
+    check(ids(catalog.select("BTC")) == "BTCUSDT,BTCUSD_PERP,BTCUSDT_PERP,BTCUSDT", "select by base");
+    check(ids(catalog.select("", "USDT")) == "BTCUSDT,ETHUSDT,BTCUSDT_PERP,XRPUSDT,BTCUSDT", "select by quote");
+    check(ids(catalog.select("BTC", "USDT", "swap")) == "BTCUSDT_PERP", "select by base, quote and type");
+    check(ids(catalog.select("", "", "swap", "BTC")) == "BTCUSD_PERP", "select by type and settle");
+    check(ids(catalog.select("BTC", "", "", "USDT")) == "BTCUSDT_PERP", "smallest index first, other filters still applied");
+    check(catalog.select("BTC", "EUR").empty() && catalog.select("DOGE").empty(), "unknown value: no match");
+    check(catalog.select("ETH", "USDT", "swap").empty(), "known values that never occur together");
+    check(catalog.select("").size() == catalog.size() && catalog.select("")[2] == &catalog[2],
+          "no filter: the whole catalog in order");
+    check(ids(catalog.by_settle("USDT")) == "BTCUSDT_PERP" && catalog.by_type("option").empty(), "single-field indexes");
+
+    // with_prefix(): case-insensitive on id and symbol, ordered by key, each instrument once.
+    check(ids(catalog.with_prefix("eth")) == "ethbtc,ETHUSDT", "prefix on both keys, ordered by key");
+    check(ids(catalog.with_prefix("btc/usdt")) == "BTCUSDT,BTCUSDT,BTCUSDT_PERP", "prefix on the symbol");
+    check(ids(catalog.with_prefix("BTCUSDT_")) == "BTCUSDT_PERP", "prefix on the id");
+    check(ids(catalog.with_prefix("XRP")) == "XRPUSDT", "id equal to symbol is listed once");
+    check(catalog.with_prefix("ETH").size() == 2, "an instrument matching on id and symbol appears once");
+    check(catalog.with_prefix("BTC", 2).size() == 2 && catalog.with_prefix("BTC", 100).size() == 4, "limit");
+    check(catalog.with_prefix("").size() == catalog.size(), "empty prefix matches everything once");
+    check(catalog.with_prefix("ZZZ").empty() && catalog.with_prefix("BTCUSDT_PERPX").empty(), "no match");
+
+    // Indexes hold views into the instruments: copies rebuild them, moves keep them.
+    auto original = std::make_unique<InstrumentCatalog>(sample());
+    InstrumentCatalog copy(*original);
+    InstrumentCatalog assigned;
+    assigned = *original;
+    original.reset();
+    check(copy.find("ETH/BTC") == &copy[4] && ids(copy.select("BTC", "USD")) == "BTCUSD_PERP" &&
+          copy.with_prefix("xrp").size() == 1, "copy-constructed catalog indexes its own strings");
+    check(assigned.find_by_symbol("ETH/USDT") == &assigned[1], "copy-assigned catalog indexes its own strings");
+    InstrumentCatalog moved(std::move(copy));
+    check(moved.find("ETHUSDT") == &moved[1] && moved.with_prefix("eth").size() == 2, "moved catalog keeps working");
+
+    InstrumentCatalog none;
+    check(none.empty() && !none.find("BTCUSDT") && none.select("BTC").empty() && none.with_prefix("").empty(),
+          "empty catalog");
+
+    return nccapi::test::report("instrument catalog");
+}
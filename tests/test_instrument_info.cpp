@@ -0,0 +1,90 @@
+// Offline check of InstrumentInfo / InfoCollector: the three InfoModes agree on content,
+// lazy info stays raw until a map access, copies share the arena, repeated keys keep the
+// last value and are counted once, and concurrent first accesses decode safely.
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "nccapi/instrument_info.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::InfoCollector;
+using nccapi::InfoMode;
+using nccapi::InstrumentInfo;
+using nccapi::test::check;
+
+using Pairs = std::vector<std::pair<std::string_view, std::string_view>>;
+
+const Pairs kRow = {{"symbol", "BTCUSDT"}, {"status", "TRADING"}, {"baseAsset", "BTC"}, {"quoteAsset", "USDT"}};
+const Pairs kRepeated = {{"symbol", "ETHUSDT"}, {"status", "BREAK"}, {"status", "TRADING"}, {"symbol", "ETHUSDT"}};
+
+std::map<std::string, std::string> visited(const InstrumentInfo& info) {
+    std::map<std::string, std::string> pairs;
+    info.for_each([&pairs](std::string_view key, std::string_view value) { pairs[std::string(key)] = std::string(value); });
+    return pairs;
+}
+
+} // namespace
+
+int main() {
+    InfoCollector eager(InfoMode::Eager);
+    InfoCollector lazy(InfoMode::Lazy);
+    InfoCollector skip(InfoMode::Skip);
+    InstrumentInfo e, l, s;
+    eager.assign(e, kRow);
+    lazy.assign(l, kRow);
+    skip.assign(s, kRow);
+
+    check(e.decoded() && e.size() == 4 && e.at("status") == "TRADING", "eager: a decoded map");
+    check(s.empty() && s.decoded(), "skip: nothing kept");
+    check(!l.decoded() && l.size() == 4 && !l.empty(), "lazy: size() without decoding");
+    check(visited(l) == e.map() && !l.decoded(), "lazy: for_each visits the raw pairs without decoding");
+
+    InstrumentInfo copy = l;
+    check(!copy.decoded() && visited(copy) == e.map(), "copying raw info shares the arena");
+    check(l.at("baseAsset") == "BTC" && l.decoded() && l.map() == e.map(), "lazy: decoded on the first lookup");
+    check(!copy.decoded(), "each copy decodes on its own");
+
+    InstrumentInfo moved = std::move(copy);
+    check(!moved.decoded() && moved.size() == 4 && copy.empty() && copy.decoded(), "moving raw info leaves the source empty");
+    moved["extra"] = "1";
+    check(moved.decoded() && moved.size() == 5 && l.size() == 4, "modifying decodes a private map");
+
+    // Repeated keys: last value wins and each key is counted once, in every mode.
+    InstrumentInfo er, lr;
+    eager.assign(er, kRepeated);
+    lazy.assign(lr, kRepeated);
+    check(er.size() == 2 && er.at("status") == "TRADING", "eager: repeated key keeps the last value");
+    check(!lr.decoded() && lr.size() == 2, "lazy: raw size() counts repeated keys once");
+    check(visited(lr).size() == 2 && visited(lr).at("status") == "TRADING", "lazy: for_each sees the last value only");
+    check(lr.map() == er.map() && lr.size() == 2, "lazy: decoded map matches eager");
+
+    // Rows after a repeated key still get their own entries.
+    InstrumentInfo next;
+    lazy.assign(next, kRow);
+    check(next.size() == 4 && next.at("symbol") == "BTCUSDT", "lazy: later rows unaffected");
+
+    InstrumentInfo cleared = l;
+    cleared.clear();
+    check(cleared.empty() && cleared.decoded() && l.size() == 4, "clear() drops only this instance");
+
+    // Concurrent const access decodes once, safely.
+    InstrumentInfo shared;
+    lazy.assign(shared, kRow);
+    const InstrumentInfo& view = shared;
+    std::vector<std::thread> readers;
+    std::vector<int> found(8, 0);
+    for (int t = 0; t < 8; ++t) {
+        readers.emplace_back([&view, &found, t] { found[t] = view.count("quoteAsset") == 1 && view.at("symbol") == "BTCUSDT"; });
+    }
+    for (auto& reader : readers) reader.join();
+    bool all = true;
+    for (int f : found) all = all && f;
+    check(all && shared.decoded(), "concurrent first lookups");
+
+    return nccapi::test::report("instrument info");
+}
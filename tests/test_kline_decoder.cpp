@@ -0,0 +1,220 @@
+// Offline check of decode_klines with every exchange's KlineLayout on a trimmed sample response,
+// for double and fixed-point rows, the edge cases of the SAX path (appending, rollback,
+// nested values, partial rows), plus a throughput figure on a large Rows payload.
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "nccapi/sessions/kline_layouts.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Candle;
+using nccapi::FixedCandle;
+using nccapi::FixedScale;
+using nccapi::KlineLayout;
+using nccapi::test::check;
+using nccapi::test::same;
+
+// The exchange classes' own layouts, so a wrong column index or member name fails here.
+namespace layouts = nccapi::kline_layouts;
+
+static_assert(layouts::kCoinbase.column_fields()[3] == KlineLayout::kOpen, "Coinbase column 3 is the open");
+static_assert(layouts::kBitstamp.field_for("volume") == KlineLayout::kVolume && layouts::kBitstamp.field_for("vwap") == -1,
+              "Bitstamp member names resolve at compile time");
+
+// GET /0/public/OHLC?pair=XBTUSD&interval=1
+const char* kKrakenBody = R"({"error":[],"result":{"XXBTZUSD":[
+[1718000040,"69534.1","69552.0","69521.2","69530.0","69540.3","18.74511",212],
+[1718000100,"69530.0","69533.3","69490.0","69492.4","69510.8","21.0447",198]],"last":1718000100}})";
+
+// GET /products/BTC-USD/candles (newest first, numbers)
+const char* kCoinbaseBody = R"([[1718000100,69490.0,69533.3,69530.0,69492.4,21.0447],
+[1718000040,69521.2,69552.0,69534.1,69530.0,18.74511]])";
+
+// GET /api/v4/futures/usdt/candlesticks (volume in contracts, nested "sum" ignored)
+const char* kGateioPerpBody = R"([{"t":1718000040,"o":"69534.1","h":"69552","l":"69521.2","c":"69530","v":1874,"sum":"1303569"},
+{"t":1718000100,"o":"69530","h":"69533.3","l":"69490","c":"69492.4","v":2104,"sum":"1462940"}])";
+
+// GET /api/v2/ohlc/btcusd/
+const char* kBitstampBody = R"({"data":{"pair":"BTC/USD","ohlc":[
+{"timestamp":"1718000040","open":"69534.1","high":"69552","low":"69521.2","close":"69530","volume":"18.74511"}]}})";
+
+// public/get_tradingview_chart_data (parallel arrays; "cost" ignored)
+const char* kDeribitBody = R"({"jsonrpc":"2.0","result":{"volume":[18.74511,21.0447],"ticks":[1718000040000,1718000100000],
+"status":"ok","open":[69534.1,69530.0],"low":[69521.2,69490.0],"high":[69552.0,69533.3],"cost":[1,2],"close":[69530.0,69492.4]}})";
+
+// GET /api/v4/spot/candlesticks: [sec, quote volume, close, high, low, open, base volume, closed]
+const char* kGateioBody = R"([["1718000040","1303569.91","69530","69552","69521.2","69534.1","18.74511","true"]])";
+
+// GET /v2/candles/trade:1m:tBTCUSD/hist: [ms, open, close, high, low, volume]
+const char* kBitfinexBody = R"([[1718000040000,69534.1,69530,69552,69521.2,18.74511]])";
+
+// GET /api/v1/public/kline: [sec, open, close, high, low, base volume, quote volume]
+const char* kWhitebitBody = R"({"success":true,"message":"","result":[[1718000040,"69534.1","69530","69552","69521.2","18.74511","1303569.91"]]})";
+const char* kWhitebitBareBody = R"([[1718000040,"69534.1","69530","69552","69521.2","18.74511","1303569.91"]])";
+
+// GET /api/v2/mix/market/candles
+const char* kBitgetFuturesBody = R"({"code":"00000","msg":"success","requestTime":1718000100000,
+"data":[["1718000040000","69534.1","69552","69521.2","69530","18.74511","1303569.91"]]})";
+
+// GET /spot/quotation/v3/lite-klines
+const char* kBitmartBody = R"({"code":1000,"trace":"a1b2","message":"success",
+"data":[["1718000040","69534.1","69552","69521.2","69530","18.74511","1303569.91"]]})";
+
+// public/get-candlestick ("interval" precedes the container)
+const char* kCryptocomBody = R"({"id":1,"method":"public/get-candlestick","code":0,"result":{"interval":"1m",
+"data":[{"o":"69534.1","h":"69552","l":"69521.2","c":"69530","v":"18.74511","t":1718000040000}],"instrument_name":"BTC_USDT"}})";
+
+// GET /api/charts/v1/trade/PF_XBTUSD/1m
+const char* kKrakenFuturesBody = R"({"candles":[{"time":1718000040000,"open":"69534.1","high":"69552","low":"69521.2",
+"close":"69530","volume":"18.74511"}],"more_candles":false})";
+
+// GET /v2/candles/btcusd/1m (newest first)
+const char* kGeminiBody = R"([[1718000100000,69530,69533.3,69490,69492.4,21.0447],[1718000040000,69534.1,69552,69521.2,69530,18.74511]])";
+
+// GET /market/history/kline (also the Coin-M and USDT-M swap payload)
+const char* kHuobiBody = R"({"ch":"market.btcusdt.kline.1min","status":"ok","ts":1718000100000,
+"data":[{"id":1718000040,"open":69534.1,"close":69530,"low":69521.2,"high":69552,"amount":0.02,"vol":18.74511,"count":212}]})";
+
+// GET /api/v1/contract/kline/BTC_USDT (parallel arrays, second timestamps)
+const char* kMexcFuturesBody = R"({"success":true,"code":0,"data":{"time":[1718000040,1718000100],"open":[69534.1,69530],
+"close":[69530,69492.4],"high":[69552,69533.3],"low":[69521.2,69490],"vol":[1874,2104],"amount":[1303569.91,1462940.2]}})";
+
+// The row every sample above holds at 1718000040 (Gemini: the second one).
+bool is_reference_row(const Candle& candle, double volume = 18.74511) {
+    return candle.timestamp == 1718000040000ULL && same(candle.open, 69534.1) && same(candle.high, 69552) &&
+           same(candle.low, 69521.2) && same(candle.close, 69530) && same(candle.volume, volume);
+}
+
+template <const KlineLayout& Layout>
+bool decodes_reference_row(const char* body, size_t rows = 1, size_t at = 0, double volume = 18.74511) {
+    std::vector<Candle> candles;
+    return nccapi::decode_klines<Layout>(body, candles) && candles.size() == rows && is_reference_row(candles[at], volume);
+}
+
+std::string large_rows_body(size_t rows) {
+    std::string body = "[";
+    for (size_t i = 0; i < rows; ++i) {
+        if (i) body += ',';
+        body += "[" + std::to_string(1718000040000LL + 60000LL * i) +
+                R"(,"69534.01","69551.99","69521.23","69530.00","18.74511",1718000099999,"1303569.91"])";
+    }
+    return body + "]";
+}
+
+} // namespace
+
+int main() {
+    std::vector<Candle> candles;
+    check(nccapi::decode_klines<layouts::kKraken>(kKrakenBody, candles), "kraken: container found");
+    check(candles.size() == 2 && candles[0].timestamp == 1718000040000ULL && same(candles[0].open, 69534.1) &&
+          same(candles[1].volume, 21.0447), "kraken: rows under a wildcard key, volume from column 6");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kCoinbase>(kCoinbaseBody, candles), "coinbase: container found");
+    check(candles.size() == 2 && same(candles[0].open, 69530.0) && same(candles[0].low, 69490.0) &&
+          same(candles[1].high, 69552.0) && candles[1].timestamp == 1718000040000ULL, "coinbase: reordered columns");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kGateioPerpetualFutures>(kGateioPerpBody, candles), "gateio perp: container found");
+    check(candles.size() == 2 && same(candles[0].volume, 1874) && same(candles[1].close, 69492.4),
+          "gateio perp: objects, unknown members skipped");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kBitstamp>(kBitstampBody, candles), "bitstamp: container found");
+    check(candles.size() == 1 && candles[0].timestamp == 1718000040000ULL && same(candles[0].high, 69552),
+          "bitstamp: objects two keys deep, quoted second timestamps");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kDeribit>(kDeribitBody, candles), "deribit: container found");
+    check(candles.size() == 2 && candles[1].timestamp == 1718000100000ULL && same(candles[1].high, 69533.3) &&
+          same(candles[0].volume, 18.74511), "deribit: parallel columns in any member order");
+
+    check(decodes_reference_row<layouts::kGateio>(kGateioBody, 1, 0, 1303569.91), "gateio: reordered string columns, volume from column 1");
+    check(decodes_reference_row<layouts::kBitfinex>(kBitfinexBody), "bitfinex: close before high and low");
+    check(decodes_reference_row<layouts::kWhitebit>(kWhitebitBody), "whitebit: rows under result");
+    check(decodes_reference_row<layouts::kWhitebitBare>(kWhitebitBareBody), "whitebit: bare array");
+    check(decodes_reference_row<layouts::kBitgetFutures>(kBitgetFuturesBody), "bitget futures: string ms timestamps under data");
+    check(decodes_reference_row<layouts::kBitmart>(kBitmartBody), "bitmart: string second timestamps under data");
+    check(decodes_reference_row<layouts::kCryptocom>(kCryptocomBody), "crypto.com: objects two keys deep");
+    check(decodes_reference_row<layouts::kKrakenFutures>(kKrakenFuturesBody), "kraken futures: objects under candles");
+    check(decodes_reference_row<layouts::kGemini>(kGeminiBody, 2, 1), "gemini: rows, newest first");
+    check(decodes_reference_row<layouts::kHuobi>(kHuobiBody) && decodes_reference_row<layouts::kHuobiCoinSwap>(kHuobiBody) &&
+          decodes_reference_row<layouts::kHuobiUsdtSwap>(kHuobiBody), "huobi spot and swaps: volume from vol");
+    check(decodes_reference_row<layouts::kMexcFutures>(kMexcFuturesBody, 2, 0, 1874), "mexc futures: parallel columns");
+
+    candles.clear();
+    check(!nccapi::decode_klines<layouts::kKraken>(R"({"error":["EQuery:Unknown asset pair"]})", candles) && candles.empty(),
+          "error payload: no container");
+    check(!nccapi::decode_klines<layouts::kMexc>(R"([[1718000040000,"1","2")", candles) && candles.empty(),
+          "truncated payload: rows dropped");
+
+    // Edge cases of the SAX path: appending, rollback, nesting and partial rows.
+    candles.assign(1, Candle());
+    candles[0].timestamp = 1;
+    check(nccapi::decode_klines<layouts::kKraken>(kKrakenBody, candles) && candles.size() == 3 && candles[0].timestamp == 1,
+          "rows are appended after existing ones");
+    check(!nccapi::decode_klines<layouts::kKraken>(R"({"result":{"XXBTZUSD":[[1718000040,"1","2","1","1","1","1",1],[17180)", candles) &&
+          candles.size() == 3, "malformed payload: only this call's rows are removed");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kKraken>(R"({"result":{"A":[[1718000040,"1","2","0.5","1.5","1","7",1]],
+"B":[[1718000100,"9","9","9","9","9","9",1]]}})", candles) &&
+          candles.size() == 1 && same(candles[0].volume, 7), "only the first matching container is decoded");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kKraken>(R"({"result":{"XXBTZUSD":[[1718000040,"1","2","0.5","1.5","1","7",[1,2]],
+[null,"1","2","0.5","1.5","1","7",1],[1718000100,"2","3","1","2.5","1","8",{"n":1}]]}})", candles) &&
+          candles.size() == 2 && candles[1].timestamp == 1718000100000ULL && same(candles[1].close, 2.5),
+          "rows: nested values skipped, rows without a timestamp dropped");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kGateioPerpetualFutures>(R"([{"sum":{"t":5,"o":"9"},"t":1718000040,"o":"1","h":"2","l":"0.5","c":"1.5","v":3},
+{"o":"1","h":"2","l":"0.5","c":"1.5","v":3}])", candles) &&
+          candles.size() == 1 && candles[0].timestamp == 1718000040000ULL && same(candles[0].open, 1),
+          "objects: members of nested objects ignored, rows without a timestamp dropped");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kDeribit>(R"({"result":{"ticks":[1718000040000],"open":[1,2],"high":[2,3],"low":[0.5,1],
+"close":[1.5,2.5],"volume":[7,8]}})", candles) && candles.size() == 1 && same(candles[0].volume, 7),
+          "columns: rows past the shortest timestamp column dropped");
+
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kMexc>("[]", candles) && candles.empty(), "empty container: found, no rows");
+    check(!nccapi::decode_klines<layouts::kDeribit>(R"({"result":[]})", candles) && candles.empty(),
+          "container of the wrong kind is not matched");
+
+    std::vector<FixedCandle> fixed;
+    FixedScale scale;
+    scale.price = 2;
+    scale.volume = 5;
+    check(nccapi::decode_klines<layouts::kKraken>(kKrakenBody, scale, fixed), "kraken fixed: container found");
+    check(fixed.size() == 2 && fixed[0].open == 6953410 && fixed[0].volume == 1874511,
+          "kraken fixed: mantissas at the requested scale");
+    fixed.clear();
+    check(nccapi::decode_klines<layouts::kKraken>(R"({"result":{"XXBTZUSD":[[1718000040,"1","2","0.5","1.5","1","99999999999999999",1],
+[1718000100,"1","2","0.5","abc","1","7",1],[1718000160,"2","3","1","2.5","1","8",1]]}})", scale, fixed) &&
+          fixed.size() == 1 && fixed[0].timestamp == 1718000160000ULL,
+          "fixed: rows with an overflowing or non-numeric field dropped, not zeroed");
+    candles.clear();
+    check(nccapi::decode_klines<layouts::kDeribit>(R"({"result":{"ticks":[1718000040000,1718000100000],"open":[1,"x"],"high":[2,3],
+"low":[0.5,1],"close":[1.5,2.5],"volume":[7,8]}})", candles) && candles.size() == 1 && same(candles[0].volume, 7),
+          "columns: a row with a non-numeric value dropped");
+
+    const size_t rows = 100000;
+    const std::string body = large_rows_body(rows);
+    candles.clear();
+    candles.reserve(rows);
+    auto start = std::chrono::steady_clock::now();
+    bool decoded = nccapi::decode_klines<layouts::kMexc>(body, candles);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    check(decoded && candles.size() == rows && candles.back().timestamp == 1718000040000ULL + 60000ULL * (rows - 1),
+          "large payload: every row decoded");
+    std::cout << rows << " rows (" << body.size() / 1024 << " KiB): " << ns / rows << " ns/row, "
+              << body.size() / (ns / 1e9) / (1024.0 * 1024.0) << " MiB/s" << std::endl;
+
+    return nccapi::test::report("kline decoder");
+}
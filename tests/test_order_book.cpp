@@ -0,0 +1,87 @@
+// Offline check of OrderBook: snapshot + deltas on a tick grid, best-first views, depth
+// trimming, plus an update throughput figure on a depth-stream-like workload.
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "nccapi/order_book.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::OrderBook;
+using nccapi::test::check;
+using nccapi::test::same;
+
+} // namespace
+
+int main() {
+    OrderBook book(0.01, 5);
+    check(book.to_ticks(69534.13) == 6953413 && same(book.to_price(6953413), 69534.13), "prices map to ticks and back");
+
+    // Snapshot
+    book.set(OrderBook::Side::Bid, 100.00, 1.0);
+    book.set(OrderBook::Side::Bid, 100.02, 2.0);
+    book.set(OrderBook::Side::Bid, 99.97, 3.0);
+    book.set(OrderBook::Side::Ask, 100.05, 4.0);
+    book.set(OrderBook::Side::Ask, 100.03, 5.0);
+    auto bids = book.bids();
+    auto asks = book.asks();
+    check(bids.size() == 3 && same(bids.price(0), 100.02) && same(bids.price(1), 100.00) && same(bids.price(2), 99.97),
+          "bids best (highest) first");
+    check(asks.size() == 2 && same(asks.price(0), 100.03) && same(asks.quantity(0), 5.0) && same(asks.price(1), 100.05),
+          "asks best (lowest) first");
+
+    // Deltas: update, insert inside, remove, remove a missing level
+    book.set(OrderBook::Side::Bid, 100.00, 1.5);
+    book.set(OrderBook::Side::Bid, 100.01, 0.5);
+    book.set(OrderBook::Side::Bid, 100.02, 0.0);
+    book.set(OrderBook::Side::Ask, 100.04, 0.0);
+    bids = book.bids(2);
+    check(bids.size() == 2 && same(bids.price(0), 100.01) && same(bids.quantity(0), 0.5) && same(bids.quantity(1), 1.5),
+          "deltas applied, top-2 view");
+    check(book.asks().size() == 2, "removing a missing level is a no-op");
+
+    // Levels beyond max_depth are not exposed, and trimmed from the worst end.
+    for (int i = 0; i < 20; ++i) book.set(OrderBook::Side::Ask, 101.00 + i * 0.01, 1.0);
+    asks = book.asks();
+    check(asks.size() == 5 && same(asks.price(0), 100.03) && same(asks.price(4), 101.02), "view capped at max_depth");
+    book.set(OrderBook::Side::Ask, 100.03, 0.0);
+    asks = book.asks();
+    check(asks.size() == 5 && same(asks.price(0), 100.05) && same(asks.price(3), 101.02), "next level moves up after a removal");
+
+    book.clear();
+    check(book.bids().empty() && book.asks().empty(), "clear empties both sides");
+
+    // Throughput: 1000-level book, updates concentrated near the top like a diff depth stream.
+    const int levels = 1000;
+    const int updates = 2000000;
+    OrderBook big(0.01, levels);
+    const int64_t mid = 6953400;
+    for (int i = 1; i <= levels; ++i) {
+        big.set_ticks(OrderBook::Side::Bid, mid - i, 1.0);
+        big.set_ticks(OrderBook::Side::Ask, mid + i, 1.0);
+    }
+    std::mt19937_64 rng(42);
+    std::geometric_distribution<int> distance(0.05);
+    std::vector<int64_t> ticks(updates);
+    std::vector<double> sizes(updates);
+    for (int i = 0; i < updates; ++i) {
+        ticks[i] = 1 + distance(rng) % levels;
+        sizes[i] = (rng() % 8 == 0) ? 0.0 : 0.5 + static_cast<double>(rng() % 100) / 10.0;
+    }
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < updates; ++i) {
+        if (i & 1) big.set_ticks(OrderBook::Side::Bid, mid - ticks[i], sizes[i]);
+        else big.set_ticks(OrderBook::Side::Ask, mid + ticks[i], sizes[i]);
+        checksum += big.bids(1).empty() ? 0.0 : big.bids(1).quantity(0);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    check(checksum > 0, "benchmark book not empty");
+    std::cout << updates << " level updates: " << ns / updates << " ns/update, "
+              << updates / (ns / 1e9) / 1e6 << " M updates/s" << std::endl;
+
+    return nccapi::test::report("order book");
+}
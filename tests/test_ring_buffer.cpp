@@ -0,0 +1,131 @@
+// Offline check of SpscRing / MpscRing / Channel: ordering and completeness across
+// threads for every wait strategy, full-ring drops, close() draining, plus the
+// producer-to-consumer handoff latency of each strategy.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "nccapi/candle_stream.hpp"
+#include "nccapi/ring_buffer.hpp"
+#include "nccapi/trade_stream.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Channel;
+using nccapi::MpscRing;
+using nccapi::SpscRing;
+using nccapi::WaitStrategy;
+using nccapi::test::check;
+
+static_assert(std::is_trivially_copyable<nccapi::CandleUpdate>::value && std::is_trivially_copyable<nccapi::Trade>::value,
+              "streaming records can be queued");
+
+const char* name(WaitStrategy wait) {
+    switch (wait) {
+        case WaitStrategy::BusySpin: return "busy-spin";
+        case WaitStrategy::Yield: return "yield";
+        case WaitStrategy::Blocking: return "blocking";
+    }
+    return "";
+}
+
+struct Record {
+    uint32_t producer = 0;
+    uint64_t sequence = 0;
+    int64_t sent_ns = 0;
+};
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Every record arrives once, in order per producer. Producers retry on a full ring.
+template <template <typename> class Ring>
+bool transfer(WaitStrategy wait, uint32_t producers, uint64_t per_producer) {
+    Channel<Record, Ring> channel(1024, wait);
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&channel, p, per_producer] {
+            for (uint64_t i = 0; i < per_producer; ++i) {
+                Record record;
+                record.producer = p;
+                record.sequence = i;
+                while (!channel.push(record)) std::this_thread::yield();
+            }
+        });
+    }
+    std::thread closer([&] {
+        for (auto& thread : threads) thread.join();
+        channel.close();
+    });
+
+    std::vector<uint64_t> next(producers, 0);
+    bool ordered = true;
+    Record record;
+    while (channel.pop(record)) {
+        if (record.sequence != next[record.producer]++) ordered = false;
+    }
+    closer.join();
+    return ordered && std::all_of(next.begin(), next.end(), [per_producer](uint64_t n) { return n == per_producer; });
+}
+
+// Median handoff latency with a paced producer (the consumer is idle between records).
+int64_t handoff_ns(WaitStrategy wait) {
+    Channel<Record> channel(1024, wait);
+    const int samples = 20000;
+    std::vector<int64_t> latencies;
+    latencies.reserve(samples);
+    std::thread consumer([&] {
+        Record record;
+        while (channel.pop(record)) latencies.push_back(now_ns() - record.sent_ns);
+    });
+    for (int i = 0; i < samples; ++i) {
+        const int64_t until = now_ns() + 5000;
+        while (now_ns() < until) {}
+        Record record;
+        record.sent_ns = now_ns();
+        channel.push(record);
+    }
+    channel.close();
+    consumer.join();
+    std::sort(latencies.begin(), latencies.end());
+    return latencies.empty() ? -1 : latencies[latencies.size() / 2];
+}
+
+} // namespace
+
+int main() {
+    SpscRing<int> ring(5);
+    check(ring.capacity() == 8, "capacity rounded up to a power of two");
+    int value = 0;
+    for (int i = 0; i < 8; ++i) check(ring.try_push(i), "push until full");
+    check(!ring.try_push(8), "full ring rejects");
+    check(ring.try_pop(value) && value == 0 && ring.try_push(8), "pop frees a slot");
+
+    MpscRing<int> mpsc(4);
+    for (int i = 0; i < 4; ++i) mpsc.try_push(i);
+    check(!mpsc.try_push(4) && mpsc.try_pop(value) && value == 0 && mpsc.try_push(4), "mpsc full / wrap-around");
+
+    Channel<int> dropping(2);
+    dropping.push(1);
+    dropping.push(2);
+    check(!dropping.push(3) && dropping.dropped() == 1, "full channel drops and counts");
+    dropping.close();
+    check(!dropping.push(4) && dropping.pop(value) && value == 1 && dropping.pop(value) && value == 2 && !dropping.pop(value),
+          "close() drains, then pop() returns false");
+
+    const unsigned cores = std::thread::hardware_concurrency();
+    for (WaitStrategy wait : {WaitStrategy::BusySpin, WaitStrategy::Yield, WaitStrategy::Blocking}) {
+        // Spinning consumers need a core of their own.
+        if (wait == WaitStrategy::BusySpin && cores < 2) continue;
+        check(transfer<SpscRing>(wait, 1, 1000000), "spsc: every record, in order");
+        check(transfer<MpscRing>(wait, 4, 250000), "mpsc: every record, in order per producer");
+        std::cout << name(wait) << ": median handoff " << handoff_ns(wait) << " ns" << std::endl;
+    }
+
+    return nccapi::test::report("ring buffer");
+}
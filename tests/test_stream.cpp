@@ -0,0 +1,68 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "nccapi/client.hpp"
+
+// ANSI color codes
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+// Args: [exchange] [instrument] [timeframe] [seconds]
+int main(int argc, char* argv[]) {
+    std::string exchange = argc > 1 ? argv[1] : "binance";
+    std::string instrument = argc > 2 ? argv[2] : "BTCUSDT";
+    std::string timeframe = argc > 3 ? argv[3] : "1m";
+    int seconds = argc > 4 ? std::stoi(argv[4]) : 150;
+
+    nccapi::Client client;
+    std::mutex print_mutex;
+    std::atomic<int> updates{0};
+    std::atomic<int> closed{0};
+    std::atomic<int64_t> worst_close_delay_ms{0};
+
+    std::cout << CYAN << "Streaming " << timeframe << " candles of " << instrument << " on " << exchange
+              << " for " << seconds << "s" << RESET << std::endl;
+
+    try {
+        auto subscription = client.subscribe_candles(exchange, instrument, timeframe, [&](const nccapi::CandleUpdate& update) {
+            ++updates;
+            if (!update.closed) return;
+            ++closed;
+            // How long after the bar's end its close reached us.
+            int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            int64_t delay = now - static_cast<int64_t>(update.candle.timestamp) - update.timeframe.ms();
+            if (delay > worst_close_delay_ms) worst_close_delay_ms = delay;
+            std::lock_guard<std::mutex> lock(print_mutex);
+            std::cout << GREEN << "[CLOSED] " << RESET << update.candle.toString() << " (+" << delay << "ms)" << std::endl;
+        });
+
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        subscription.cancel();
+    } catch (const std::exception& e) {
+        std::cerr << RED << "Test Failed: " << e.what() << RESET << std::endl;
+        return 1;
+    }
+
+    std::cout << "Updates: " << updates << ", closed bars: " << closed
+              << ", worst close delay: " << worst_close_delay_ms << "ms" << std::endl;
+    if (updates == 0) {
+        std::cout << YELLOW << "Warning: no update received (stream unsupported by ccapi for this exchange?)" << RESET << std::endl;
+    }
+
+    // Invalid timeframes are rejected before subscribing
+    try {
+        client.subscribe_candles(exchange, instrument, "7x", [](const nccapi::CandleUpdate&) {});
+        std::cout << RED << "[FAIL] Invalid timeframe accepted" << RESET << std::endl;
+        return 1;
+    } catch (const std::invalid_argument& e) {
+        std::cout << GREEN << "Invalid timeframe rejected: " << e.what() << RESET << std::endl;
+    }
+    return 0;
+}
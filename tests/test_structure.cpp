@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <chrono>
 #include "nccapi/client.hpp"
 
 int main() {
@@ -24,5 +25,23 @@ int main() {
         }
     }
 
+    // Same catalogs through the concurrent fan-out: one deadline for every exchange.
+    std::cout << "\nFetching pairs for all exchanges at once..." << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    auto all_pairs = client.get_all_pairs(std::chrono::seconds(20));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& exchange : exchanges) {
+        const auto& result = all_pairs[exchange];
+        if (result.status == nccapi::FetchStatus::Timeout) {
+            std::cerr << "Timed out fetching pairs for " << exchange << std::endl;
+        } else if (result.status == nccapi::FetchStatus::Error) {
+            std::cerr << "Error fetching pairs for " << exchange << ": " << result.error << std::endl;
+        } else {
+            std::cout << exchange << ": " << result.instruments.size() << " pairs" << std::endl;
+        }
+    }
+    std::cout << "\nFetched all catalogs in " << elapsed << " ms." << std::endl;
+
     return 0;
 }
@@ -0,0 +1,35 @@
+#ifndef NCCAPI_TESTS_TEST_SUPPORT_HPP
+#define NCCAPI_TESTS_TEST_SUPPORT_HPP
+
+// Helpers shared by the offline test executables: record failed checks, compare doubles,
+// and turn the tally into the process exit code.
+#include <iostream>
+
+namespace nccapi::test {
+
+inline int failures = 0;
+
+inline void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "[FAIL] " << what << std::endl;
+        ++failures;
+    }
+}
+
+inline bool same(double a, double b, double tolerance = 1e-9) { return a - b < tolerance && b - a < tolerance; }
+
+/**
+ * @brief Print the outcome ("All <name> checks passed.") and return main's exit code.
+ */
+inline int report(const char* name) {
+    if (failures) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All " << name << " checks passed." << std::endl;
+    return 0;
+}
+
+} // namespace nccapi::test
+
+#endif // NCCAPI_TESTS_TEST_SUPPORT_HPP
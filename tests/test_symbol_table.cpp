@@ -0,0 +1,61 @@
+// Offline check of SymbolTable: stable ids, the reserved empty id, lookups that do not
+// intern, names surviving block growth and oversized strings, and move semantics.
+#include <string>
+#include <string_view>
+#include <vector>
+#include "nccapi/symbol_table.hpp"
+#include "test_support.hpp"
+
+using nccapi::SymbolId;
+using nccapi::SymbolTable;
+using nccapi::test::check;
+
+int main() {
+    SymbolTable table;
+    check(table.size() == 1 && table.name(SymbolTable::kEmpty).empty(), "a new table holds only the empty string");
+    check(table.intern("") == SymbolTable::kEmpty && table.find("") == SymbolTable::kEmpty, "empty string is id 0");
+
+    SymbolId btc = table.intern("BTC");
+    SymbolId usdt = table.intern("USDT");
+    check(btc != usdt && btc != SymbolTable::kEmpty, "distinct strings get distinct ids");
+    std::string copy = "BTC";
+    check(table.intern(copy) == btc && table.size() == 3, "interning again returns the same id");
+    check(table.name(btc) == "BTC" && table.name(usdt) == "USDT", "name() returns the interned text");
+    check(table.name(btc).data() != copy.data(), "names are copied into the table");
+
+    check(table.find("ETH") == SymbolTable::kNotFound && table.size() == 3, "find() does not intern");
+    check(table.find(std::string_view("USDT-PERP", 4)) == usdt, "lookups by a view of a longer string");
+    check(table.intern("btc") != btc, "case-sensitive");
+
+    // Fill several blocks: earlier views must stay valid and ids stay dense.
+    const std::string_view first = table.name(btc);
+    std::vector<SymbolId> ids;
+    for (int i = 0; i < 20000; ++i) ids.push_back(table.intern("INSTRUMENT-" + std::to_string(i)));
+    bool dense = true;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] != ids[0] + i || table.name(ids[i]) != "INSTRUMENT-" + std::to_string(i)) dense = false;
+    }
+    check(dense, "ids are assigned densely and map back to their strings");
+    check(first.data() == table.name(btc).data() && first == "BTC", "views survive block growth");
+
+    // Strings larger than a block get their own allocation without disturbing the current block.
+    const std::string big(40000, 'x');
+    SymbolId big_id = table.intern(big);
+    SymbolId after = table.intern("AFTER-BIG");
+    check(table.name(big_id) == big && table.name(after) == "AFTER-BIG", "oversized strings are stored whole");
+    check(table.intern("INSTRUMENT-0") == ids[0], "existing ids unchanged after an oversized string");
+
+    SymbolTable oversized_first;
+    SymbolId lone = oversized_first.intern(big);
+    SymbolId small = oversized_first.intern("S");
+    check(oversized_first.name(lone) == big && oversized_first.name(small) == "S", "oversized string as the first entry");
+
+    check(table.memory_usage() >= big.size() + 20000 * sizeof(std::string_view), "memory_usage counts blocks and views");
+
+    const size_t size = table.size();
+    SymbolTable moved(std::move(table));
+    check(moved.size() == size && moved.find("BTC") == btc && moved.name(usdt) == "USDT" &&
+          moved.name(btc).data() == first.data(), "moving keeps ids and storage");
+
+    return nccapi::test::report("symbol table");
+}
@@ -0,0 +1,82 @@
+// Offline check of decode_tickers on trimmed all-symbols ticker responses of each
+// supported exchange, plus the TickerTable columns built from them.
+#include <iostream>
+#include <string>
+#include "nccapi/sessions/ticker_decoder.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::TickerLayout;
+using nccapi::TickerTable;
+using nccapi::test::check;
+using nccapi::test::same;
+
+// Same descriptors as the exchange classes.
+constexpr TickerLayout kBinance = TickerLayout::objects({}, {{"symbol", "lastPrice", "bidPrice", "askPrice", "volume"}});
+constexpr TickerLayout kOkxSwap = TickerLayout::objects({"data"}, {{"instId", "last", "bidPx", "askPx", "volCcy24h"}});
+constexpr TickerLayout kBybit = TickerLayout::objects({"result", "list"}, {{"symbol", "lastPrice", "bid1Price", "ask1Price", "volume24h"}});
+constexpr TickerLayout kGateio = TickerLayout::objects({}, {{"currency_pair", "last", "highest_bid", "lowest_ask", "base_volume"}});
+constexpr TickerLayout kKucoin = TickerLayout::objects({"data", "ticker"}, {{"symbol", "last", "buy", "sell", "vol"}});
+
+static_assert(kBybit.field_for("ask1Price") == TickerLayout::kAsk && kBybit.field_for("turnover24h") == -1,
+              "member names resolve at compile time");
+
+// GET /api/v3/ticker/24hr
+const char* kBinanceBody = R"([{"symbol":"ETHBTC","priceChange":"0.0001","lastPrice":"0.05105","bidPrice":"0.05104","bidQty":"12.1",
+"askPrice":"0.05105","volume":"31005.9","quoteVolume":"1582.7","count":112233},
+{"symbol":"BTCUSDT","lastPrice":"69530.00","bidPrice":"69529.99","askPrice":"69530.00","volume":"18774.5"}])";
+
+// GET /api/v5/market/tickers?instType=SWAP
+const char* kOkxBody = R"({"code":"0","msg":"","data":[{"instType":"SWAP","instId":"BTC-USDT-SWAP","last":"69530.1",
+"bidPx":"69530","askPx":"69530.1","vol24h":"1893421","volCcy24h":"18934.21","ts":"1718000040000"}]})";
+
+// GET /v5/market/tickers?category=spot (numbers quoted, nested category ignored)
+const char* kBybitBody = R"({"retCode":0,"retMsg":"OK","result":{"category":"spot","list":[
+{"symbol":"BTCUSDT","bid1Price":"69529.9","ask1Price":"69530","lastPrice":"69530","volume24h":"5123.4"},
+{"symbol":"ETHUSDT","bid1Price":"3701.1","ask1Price":"3701.2","lastPrice":"3701.2","volume24h":"60111"}]},"time":1718000040000})";
+
+// GET /api/v4/spot/tickers (empty bid on an illiquid pair)
+const char* kGateioBody = R"([{"currency_pair":"BTC_USDT","last":"69530","lowest_ask":"69530.1","highest_bid":"69530","base_volume":"8123.5"},
+{"currency_pair":"ABC_USDT","last":"0.01","lowest_ask":"0.011","highest_bid":"","base_volume":"0"}])";
+
+// GET /api/v1/market/allTickers
+const char* kKucoinBody = R"({"code":"200000","data":{"time":1718000040000,"ticker":[
+{"symbol":"BTC-USDT","symbolName":"BTC-USDT","buy":"69529.9","sell":"69530","last":"69530","vol":"1403.2","volValue":"97560000"}]}})";
+
+} // namespace
+
+int main() {
+    TickerTable tickers;
+    check(nccapi::decode_tickers<kBinance>(kBinanceBody, "spot", tickers), "binance: array found");
+    check(tickers.size() == 2 && tickers.instrument(0) == "ETHBTC" && same(tickers.bids()[0], 0.05104) &&
+          same(tickers.volumes()[0], 31005.9) && same(tickers.lasts()[1], 69530.0), "binance: root array of objects");
+
+    check(nccapi::decode_tickers<kOkxSwap>(kOkxBody, "swap", tickers), "okx: array found");
+    check(tickers.size() == 3 && tickers.instrument(2) == "BTC-USDT-SWAP" && tickers.type(2) == "swap" &&
+          same(tickers.asks()[2], 69530.1) && same(tickers.volumes()[2], 18934.21), "okx: appended, base volume");
+
+    TickerTable bybit;
+    check(nccapi::decode_tickers<kBybit>(kBybitBody, "spot", bybit), "bybit: array found");
+    check(bybit.size() == 2 && bybit.find("ETHUSDT") == 1 && same(bybit[1].bid, 3701.1) && same(bybit[1].volume, 60111),
+          "bybit: array two keys deep");
+
+    TickerTable gateio;
+    check(nccapi::decode_tickers<kGateio>(kGateioBody, "spot", gateio), "gateio: array found");
+    check(gateio.size() == 2 && same(gateio.bids()[1], 0.0) && same(gateio.asks()[1], 0.011), "gateio: empty field left at 0");
+
+    TickerTable kucoin;
+    check(nccapi::decode_tickers<kKucoin>(kKucoinBody, "spot", kucoin), "kucoin: array found");
+    check(kucoin.size() == 1 && kucoin.instrument(0) == "BTC-USDT" && same(kucoin[0].ask, 69530) && same(kucoin[0].volume, 1403.2),
+          "kucoin: array under data.ticker");
+
+    TickerTable errors;
+    check(!nccapi::decode_tickers<kKucoin>(R"({"code":"400100","msg":"error"})", "spot", errors) && errors.empty(),
+          "error payload: no array");
+
+    tickers.truncate(2);
+    check(tickers.size() == 2 && tickers.instrument(1) == "BTCUSDT" && tickers.find("BTC-USDT-SWAP") == TickerTable::npos,
+          "truncate drops trailing rows");
+
+    return nccapi::test::report("ticker decoder");
+}
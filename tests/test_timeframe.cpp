@@ -0,0 +1,129 @@
+// Offline check of Timeframe: parsing, bucket_start / bucket_end alignment (epoch, Monday
+// weeks, calendar months, timestamps before 1970), is_multiple_of, TimeframeTable::source_for
+// and resample_candles.
+#include <cstdint>
+#include <vector>
+#include "nccapi/timeframe.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::Candle;
+using nccapi::NativeTimeframe;
+using nccapi::Timeframe;
+using nccapi::TimeframeTable;
+using nccapi::test::check;
+using nccapi::test::same;
+using namespace nccapi::literals;
+
+constexpr int64_t kMinute = 60000;
+constexpr int64_t kDay = 86400000;
+
+// UTC timestamps (ms).
+constexpr int64_t kMonday = 1705276800000;      // 2024-01-15 00:00, a Monday
+constexpr int64_t kSample = 1705322096000;      // 2024-01-15 12:34:56
+constexpr int64_t kJan2024 = 1704067200000;
+constexpr int64_t kFeb2024 = 1706745600000;
+constexpr int64_t kMar2024 = 1709251200000;
+constexpr int64_t kApr2024 = 1711929600000;
+constexpr int64_t kOct2023 = 1696118400000;
+
+static_assert("4h"_tf == "240m"_tf && "1M"_tf != "30d"_tf && "4w"_tf < "1M"_tf, "compile-time comparison");
+static_assert("1h"_tf.is_multiple_of("15m"_tf) && !"1h"_tf.is_multiple_of("7m"_tf), "compile-time is_multiple_of");
+
+const NativeTimeframe kNative[] = {{"1m"_tf, "1"}, {"5m"_tf, "5"}, {"1h"_tf, "60"}, {"1d"_tf, "D"}};
+
+Candle candle(int64_t ts, double open, double high, double low, double close, double volume) {
+    Candle c;
+    c.timestamp = static_cast<uint64_t>(ts);
+    c.open = open;
+    c.high = high;
+    c.low = low;
+    c.close = close;
+    c.volume = volume;
+    return c;
+}
+
+} // namespace
+
+int main() {
+    Timeframe parsed;
+    check(Timeframe::parse("15m", parsed) && parsed.count() == 15 && parsed.unit() == Timeframe::Unit::Minute,
+          "parse minutes");
+    check(Timeframe::parse("1M", parsed) && parsed.unit() == Timeframe::Unit::Month && parsed.to_string() == "1M",
+          "'M' is a month");
+    parsed = "2h"_tf;
+    check(!Timeframe::parse("0m", parsed) && !Timeframe::parse("m", parsed) && !Timeframe::parse("5x", parsed) &&
+          !Timeframe::parse("-1m", parsed) && !Timeframe::parse("99999999m", parsed) && parsed == "2h"_tf,
+          "malformed text rejected, out untouched");
+
+    // bucket_start: epoch-aligned durations, Monday weeks, calendar months.
+    check("1m"_tf.bucket_start(kSample) == kSample - 56000, "minute bucket");
+    check("15m"_tf.bucket_start(kSample) == kMonday + 12 * 3600000 + 30 * kMinute, "15m bucket");
+    check("4h"_tf.bucket_start(kSample) == kMonday + 12 * 3600000, "4h bucket");
+    check("1d"_tf.bucket_start(kSample) == kMonday && "1d"_tf.bucket_start(kMonday) == kMonday, "day bucket, start inclusive");
+    check("1w"_tf.bucket_start(kSample) == kMonday && "1w"_tf.bucket_start(kMonday - 1) == kMonday - 7 * kDay,
+          "weeks start on Monday");
+    check("1M"_tf.bucket_start(kSample) == kJan2024 && "1M"_tf.bucket_start(kFeb2024 - 1) == kJan2024 &&
+          "1M"_tf.bucket_start(kFeb2024) == kFeb2024, "calendar months");
+    check("3M"_tf.bucket_start(kFeb2024 + kDay) == kJan2024 && "3M"_tf.bucket_start(kApr2024) == kApr2024 &&
+          "3M"_tf.bucket_start(kJan2024 - 1) == kOct2023, "quarters aligned to January 1970");
+
+    // Before the epoch: floor, not truncation toward zero.
+    check("1h"_tf.bucket_start(-1) == -3600000 && "1d"_tf.bucket_start(-1) == -kDay, "negative timestamps floor");
+    check("1w"_tf.bucket_start(0) == -3 * kDay, "1970-01-01 is in the week of Monday 1969-12-29");
+    check("1M"_tf.bucket_start(-1) == -31 * kDay, "December 1969");
+
+    // bucket_end: exclusive, calendar-exact for months (2024 is a leap year).
+    check("1h"_tf.bucket_end(kSample) == kMonday + 13 * 3600000, "hour end");
+    check("1M"_tf.bucket_end(kFeb2024 + 10 * kDay) == kMar2024 && "1M"_tf.bucket_end(kJan2024) == kFeb2024,
+          "month end");
+    check("3M"_tf.bucket_end(kMar2024) == kApr2024, "quarter end");
+
+    // is_multiple_of: every target bucket is made of whole base buckets.
+    check("1h"_tf.is_multiple_of("1m"_tf) && "1h"_tf.is_multiple_of("1h"_tf) && !"1h"_tf.is_multiple_of("2h"_tf),
+          "durations that divide");
+    check(!"1h"_tf.is_multiple_of("7m"_tf), "durations that do not divide");
+    check("1w"_tf.is_multiple_of("1d"_tf) && "2w"_tf.is_multiple_of("1w"_tf) && !"1w"_tf.is_multiple_of("7d"_tf),
+          "weeks: epoch-aligned 7d buckets start on Thursdays");
+    check("1M"_tf.is_multiple_of("1d"_tf) && "1M"_tf.is_multiple_of("1h"_tf) && !"1M"_tf.is_multiple_of("1w"_tf) &&
+          !"1M"_tf.is_multiple_of("2d"_tf), "months are made of days, not weeks");
+    check("3M"_tf.is_multiple_of("1M"_tf) && !"1M"_tf.is_multiple_of("3M"_tf) && !"1d"_tf.is_multiple_of("1M"_tf),
+          "months of months");
+
+    TimeframeTable table(kNative);
+    check(table.source_for("5m"_tf) == "5m"_tf && table.source_for("4h"_tf) == "1h"_tf && table.source_for("1w"_tf) == "1d"_tf,
+          "source_for: native first, then the longest divisor");
+    check(!table.source_for("30s"_tf) && table.find("1h"_tf)->code == "60", "source_for: nothing fits");
+
+    // resample_candles: open of the first, close of the last, extremes, summed volume.
+    const int64_t base = kMonday + 12 * 3600000;
+    std::vector<Candle> minutes;
+    for (int i = 0; i < 10; ++i) {
+        minutes.push_back(candle(base + i * kMinute, 100 + i, 105 + i, 95 + i, 101 + i, 1.5));
+    }
+    minutes.push_back(candle(base + 15 * kMinute, 200, 210, 190, 205, 2));
+    auto bars = nccapi::resample_candles(minutes, "5m"_tf);
+    check(bars.size() == 3, "one bar per bucket with data, gaps skipped");
+    check(bars.size() == 3 && bars[0].timestamp == static_cast<uint64_t>(base) && same(bars[0].open, 100) &&
+          same(bars[0].high, 109) && same(bars[0].low, 95) && same(bars[0].close, 105) && same(bars[0].volume, 7.5),
+          "first bar aggregates five candles");
+    check(bars.size() == 3 && bars[1].timestamp == static_cast<uint64_t>(base + 5 * kMinute) && same(bars[1].open, 105) &&
+          same(bars[1].close, 110), "second bar");
+    check(bars.size() == 3 && bars[2].timestamp == static_cast<uint64_t>(base + 15 * kMinute) && same(bars[2].volume, 2),
+          "a lone candle forms its own bar");
+
+    std::vector<Candle> offset = {candle(base + 3 * kMinute, 1, 2, 0.5, 1.5, 1)};
+    auto partial = nccapi::resample_candles(offset, "1h"_tf);
+    check(partial.size() == 1 && partial[0].timestamp == static_cast<uint64_t>(base), "bar timestamp is the bucket start");
+    check(nccapi::resample_candles({}, "1h"_tf).empty(), "no candles, no bars");
+
+    std::vector<Candle> days = {candle(kFeb2024 - kDay, 1, 1, 1, 1, 1), candle(kFeb2024, 2, 2, 2, 2, 1),
+                                candle(kMar2024 - kDay, 3, 3, 3, 3, 1)};
+    auto months = nccapi::resample_candles(days, "1M"_tf);
+    check(months.size() == 2 && months[0].timestamp == static_cast<uint64_t>(kJan2024) &&
+          months[1].timestamp == static_cast<uint64_t>(kFeb2024) && same(months[1].close, 3) && same(months[1].volume, 2),
+          "days into calendar months");
+
+    return nccapi::test::report("timeframe");
+}
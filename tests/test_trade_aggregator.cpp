@@ -0,0 +1,129 @@
+// Offline check of TradeAggregator: bucket boundaries, closes driven by trades and by the
+// clock, late trades, gap filling, monthly buckets, and DeadlineTimer-driven closes.
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "nccapi/deadline_timer.hpp"
+#include "nccapi/trade_stream.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+using nccapi::CandleUpdate;
+using nccapi::Trade;
+using nccapi::TradeAggregator;
+using nccapi::TradeAggregatorOptions;
+using nccapi::test::check;
+using nccapi::test::same;
+using namespace nccapi::literals;
+
+Trade trade(uint64_t timestamp, double price, double size) {
+    Trade t;
+    t.timestamp = timestamp;
+    t.price = price;
+    t.size = size;
+    return t;
+}
+
+struct Recorder {
+    std::vector<CandleUpdate> closed;
+    size_t forming = 0;
+    nccapi::CandleHandler handler() {
+        return [this](const CandleUpdate& update) {
+            if (update.closed) closed.push_back(update);
+            else ++forming;
+        };
+    }
+};
+
+const uint64_t kT0 = 1718000040000ULL; // 2024-06-10 06:14:00 UTC, a minute boundary
+
+} // namespace
+
+int main() {
+    {
+        Recorder bars;
+        TradeAggregator aggregator("test", "BTC-USD", "1m"_tf, bars.handler());
+        aggregator.add(trade(kT0 + 10, 100.0, 1.0));
+        aggregator.add(trade(kT0 + 20000, 105.0, 0.5));
+        aggregator.add(trade(kT0 + 59999, 95.0, 2.0));
+        check(bars.closed.empty() && bars.forming == 3, "same bucket: forming updates only");
+        aggregator.add(trade(kT0 + 60000, 96.0, 1.0)); // Exactly on the boundary: next bar
+        check(bars.closed.size() == 1, "boundary trade closes the previous bar");
+        const auto& bar = bars.closed[0].candle;
+        check(bar.timestamp == kT0 && same(bar.open, 100.0) && same(bar.high, 105.0) && same(bar.low, 95.0) &&
+              same(bar.close, 95.0) && same(bar.volume, 3.5), "OHLCV of the first bar excludes the boundary trade");
+
+        aggregator.advance(static_cast<int64_t>(kT0) + 120000 + 249);
+        check(bars.closed.size() == 1, "not closed before end + close_delay");
+        aggregator.advance(static_cast<int64_t>(kT0) + 120000 + 250);
+        check(bars.closed.size() == 2 && bars.closed[1].candle.timestamp == kT0 + 60000 &&
+              same(bars.closed[1].candle.volume, 1.0), "clock closes the bar at end + close_delay");
+
+        aggregator.add(trade(kT0 + 119000, 97.0, 1.0));
+        check(bars.closed.size() == 2 && aggregator.late_trades() == 1, "trade of a closed bar is dropped and counted");
+    }
+
+    {
+        Recorder bars;
+        TradeAggregatorOptions options;
+        options.fill_gaps = true;
+        options.close_delay = std::chrono::milliseconds(0);
+        TradeAggregator aggregator("test", "BTC-USD", "1m"_tf, bars.handler(), options);
+        aggregator.add(trade(kT0 + 5, 100.0, 1.0));
+        aggregator.add(trade(kT0 + 3 * 60000 + 5, 101.0, 1.0));
+        check(bars.closed.size() == 3 && bars.closed[1].candle.timestamp == kT0 + 60000 &&
+              bars.closed[2].candle.timestamp == kT0 + 120000 && same(bars.closed[2].candle.open, 100.0) &&
+              same(bars.closed[2].candle.volume, 0.0), "gap before a trade filled with flat bars");
+        aggregator.advance(static_cast<int64_t>(kT0) + 6 * 60000);
+        check(bars.closed.size() == 6 && bars.closed[5].candle.timestamp == kT0 + 5 * 60000 &&
+              same(bars.closed[5].candle.close, 101.0), "clock emits the flat bars that are due");
+    }
+
+    {
+        Recorder bars;
+        TradeAggregator aggregator("test", "BTC-USD", "1M"_tf, bars.handler());
+        const uint64_t feb_29 = 1709164800000ULL; // 2024-02-29 00:00:00 UTC
+        aggregator.add(trade(feb_29, 100.0, 1.0));
+        aggregator.add(trade(1709251200000ULL, 101.0, 1.0)); // 2024-03-01 00:00:00 UTC
+        check(bars.closed.size() == 1 && bars.closed[0].candle.timestamp == 1706745600000ULL,
+              "monthly bar (2024-02) closes on the first trade of March");
+        check("1M"_tf.bucket_end(static_cast<int64_t>(feb_29)) == 1709251200000LL &&
+              "3M"_tf.bucket_end(static_cast<int64_t>(feb_29)) == 1711929600000LL, "calendar-exact bucket_end");
+    }
+
+    {
+        // Bars close on time without any further trade.
+        std::mutex mutex;
+        std::vector<CandleUpdate> closed;
+        auto timer = std::make_shared<nccapi::DeadlineTimer>();
+        TradeAggregatorOptions options;
+        options.close_delay = std::chrono::milliseconds(50);
+        auto aggregator = std::make_shared<TradeAggregator>("test", "BTC-USD", "1s"_tf, [&](const CandleUpdate& update) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (update.closed) closed.push_back(update);
+        }, options);
+        std::weak_ptr<TradeAggregator> weak = aggregator;
+        aggregator->set_scheduler([timer, weak](int64_t deadline_ms) {
+            timer->schedule(deadline_ms, [weak] {
+                if (auto target = weak.lock()) {
+                    target->advance(std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count());
+                }
+            });
+        });
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        aggregator->add(trade(static_cast<uint64_t>(now), 100.0, 1.0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+        std::lock_guard<std::mutex> lock(mutex);
+        check(closed.size() == 1 && closed[0].candle.timestamp == static_cast<uint64_t>("1s"_tf.bucket_start(now)),
+              "timer closes the bar after its end");
+    }
+
+    return nccapi::test::report("trade aggregator");
+}